@@ -16,6 +16,8 @@
 #	define UNVALID_POSITION_ERROR(pos) printf("Error: The position %d is unvalid.\n", pos )
 #endif
 
+const char* STRING_TITLE = "LISTA [size: %d]\n";
+
 /**
  * Libreria che permette la gestione di una lista linkata doppiamente.
  * La lista porterà via (ovviamente) più spazio in memoria rispetto ad una ulinked_list, ma il fatto di
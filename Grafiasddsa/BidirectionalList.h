@@ -11,7 +11,7 @@
 
 #ifndef STRING_FORMATTING
 #	define STRING_FORMATTING
-	const char* STRING_TITLE = "LISTA [size: %d]\n";
+	extern const char* STRING_TITLE;
 #endif
 
 typedef struct blinked_list_node {
@@ -46,7 +46,7 @@ void bl_insertAllElementsLast(blinked_list* l, blinked_list* elements); // OK
 void bl_deleteFirstElement(blinked_list* l); // OK
 void bl_deleteLastElement(blinked_list* l); // OK
 void bl_deleteElementAtPosition(blinked_list* l, int pos); // OK
-void bh_deleteElementByContent(binaryheap* h, void* element_to_delete); /// TODO
+void bl_deleteElementByContent(blinked_list* l, void* element_to_delete); /// TODO
 void bl_deleteElementsByCondition(blinked_list* l, bool (*condition)(void*)); // OK
 void bl_deleteSubList(blinked_list* l, int start_pos, int end_pos); // OK // NEW
 
@@ -0,0 +1,42 @@
+#ifndef BITMATRIXGRAPH_H_
+#define BITMATRIXGRAPH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Graph.h"
+
+typedef struct bitmatrix_graph {
+	int vertices_number;
+	long edges_number;
+	bool directed;
+	int row_words;
+	uint64_t* rows;
+} bitmatrix_graph;
+
+// Initializing Graph
+bitmatrix_graph* bm_initGraph(int vertices_number, bool directed); // OK
+bitmatrix_graph* bm_initGraphFromGraph(graph* g); // OK
+
+// Size
+int bm_getVerticesNumber(bitmatrix_graph* g); // OK
+long bm_getEdgesNumber(bitmatrix_graph* g); // OK
+
+// Cancelling Graph
+void bm_deleteGraph(bitmatrix_graph* g); // OK
+
+// Editing Graph
+bool bm_addEdge(bitmatrix_graph* g, int source, int destination); // OK
+bool bm_deleteEdge(bitmatrix_graph* g, int source, int destination); // OK
+
+// Getting Neighbors
+bool bm_containsEdge(bitmatrix_graph* g, int source, int destination); // OK
+int bm_getVertexDegree(bitmatrix_graph* g, int vertex); // OK
+int bm_countCommonNeighbors(bitmatrix_graph* g, int first, int second); // OK
+int bm_getCommonNeighbors(bitmatrix_graph* g, int first, int second, int* common); // OK
+
+// Dense Subgraphs
+long bm_countTriangles(bitmatrix_graph* g); // OK
+bool bm_isClique(bitmatrix_graph* g, int* vertices, int vertices_number); // OK
+
+#endif
@@ -0,0 +1,284 @@
+// Necessario per "posix_memalign", non definita dallo standard C
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "ConcurrentHeap.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef EMPTY_SIZE
+#	define EMPTY_SIZE 0
+#endif
+
+#define DEFAULT_SHARDS_NUMBER 8
+
+/**
+ * Libreria che implementa una coda con priorità concorrente (thread-safe) secondo lo schema "MultiQueue".
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * La struttura è composta da più binaryheap indipendenti ("shard"), ciascuno protetto dal proprio mutex.
+ * - L'inserimento sceglie uno shard a caso fra quelli non occupati da altri thread, ed inserisce l'elemento in esso.
+ * - L'estrazione sceglie due shard a caso e, se riesce ad acquisirli entrambi, estrae la radice maggiore fra le due.
+ * In questo modo i thread raramente si contendono lo stesso lock, e il throughput cresce con il numero di thread
+ * (si consiglia un numero di shard pari a 2-4 volte il numero di thread che accedono alla struttura).
+ *
+ * <i>NOTA:</i> L'ordinamento è RILASSATO. L'elemento estratto non è necessariamente il massimo globale, ma il maggiore
+ * fra le radici di due shard: in media il suo rango (la posizione che avrebbe in un ordinamento totale) è
+ * proporzionale al numero di shard, e non cresce con il numero di elementi contenuti.
+ * Un'estrazione restituisce NULL solamente se la struttura è stata vista vuota; con un solo shard l'ordinamento
+ * torna ad essere stretto (ma tutte le operazioni vengono serializzate).
+ *
+ * <i>NOTA:</i> La funzione di comparazione ha lo stesso contratto di "bh_initHeap". Non è possibile inserire
+ * elementi NULL, poiché il valore NULL indica l'assenza di elementi da estrarre.
+ */
+
+/*
+typedef struct concurrentheap_shard {
+	pthread_mutex_t lock;
+	binaryheap* heap;
+} concurrentheap_shard;
+
+typedef struct concurrentheap {
+	int shards_number;
+	concurrentheap_shard* shards;
+	int (*comparefunction)(void*, void*);
+	int size;
+	int waiting;
+	bool closed;
+	pthread_mutex_t wait_lock;
+	pthread_cond_t not_empty;
+} concurrentheap;
+*/
+
+// Static Utility Functions
+
+static __thread uint32_t ch_random_state = 0;
+
+/**
+ * Generatore pseudo-casuale (xorshift) locale ad ogni thread, per evitare la contesa sullo stato di "rand()".
+ */
+static int ch_getRandomShard(concurrentheap* h) {
+	if (ch_random_state == 0) {
+		ch_random_state = (uint32_t)(uintptr_t)&ch_random_state | 1;
+	}
+	ch_random_state ^= ch_random_state << 13;
+	ch_random_state ^= ch_random_state >> 17;
+	ch_random_state ^= ch_random_state << 5;
+	return (int)(ch_random_state % (uint32_t)h->shards_number);
+}
+
+/**
+ * Prova ad estrarre la radice migliore fra due shard, senza bloccarsi.
+ * Restituisce NULL se non è stato possibile acquisire i lock o se entrambi gli shard sono vuoti.
+ */
+static void* ch_tryExtractFromShards(concurrentheap* h, int i, int j) {
+	concurrentheap_shard* first = &h->shards[i];
+	concurrentheap_shard* second = &h->shards[j];
+	if (pthread_mutex_trylock(&first->lock) != 0) {
+		return NULL;
+	}
+	if (i != j && pthread_mutex_trylock(&second->lock) != 0) {
+		pthread_mutex_unlock(&first->lock);
+		return NULL;
+	}
+	concurrentheap_shard* chosen = NULL;
+	if (bh_getHeapSize(first->heap) > EMPTY_SIZE) {
+		chosen = first;
+	}
+	if (i != j && bh_getHeapSize(second->heap) > EMPTY_SIZE
+			&& (!chosen || h->comparefunction(
+				second->heap->al->array[0],
+				first->heap->al->array[0]) > 0)) {
+		chosen = second;
+	}
+	void* extracted = chosen ? bh_extractRootElement(chosen->heap) : NULL;
+	if (i != j) {
+		pthread_mutex_unlock(&second->lock);
+	}
+	pthread_mutex_unlock(&first->lock);
+	return extracted;
+}
+
+/**
+ * Scorre tutti gli shard (bloccandosi sui rispettivi lock) alla ricerca di un elemento da estrarre.
+ * Viene utilizzata quando i tentativi casuali falliscono ripetutamente, ad esempio quando la struttura è quasi vuota.
+ */
+static void* ch_scanAndExtract(concurrentheap* h) {
+	void* extracted = NULL;
+	for (int i = 0; i < h->shards_number && !extracted; i++) {
+		pthread_mutex_lock(&h->shards[i].lock);
+		if (bh_getHeapSize(h->shards[i].heap) > EMPTY_SIZE) {
+			extracted = bh_extractRootElement(h->shards[i].heap);
+		}
+		pthread_mutex_unlock(&h->shards[i].lock);
+	}
+	return extracted;
+}
+
+// Initializing Heap
+
+/**
+ * Inizializza una coda con priorità concorrente composta dal numero di shard desiderato.
+ * Se il numero di shard non è positivo, viene utilizzato un valore di default.
+ */
+concurrentheap* ch_initHeap(int (*compare)(void*, void*), int shards_number) {
+	concurrentheap* new_heap = malloc(sizeof(concurrentheap));
+	if (!new_heap) {
+		MEMORY_ERROR;
+	}
+	new_heap->shards_number = shards_number > 0 ? shards_number : DEFAULT_SHARDS_NUMBER;
+	if (posix_memalign((void**)&new_heap->shards, CACHE_LINE_SIZE,
+			new_heap->shards_number * sizeof(concurrentheap_shard)) != 0) {
+		MEMORY_ERROR;
+	}
+	for (int i = 0; i < new_heap->shards_number; i++) {
+		pthread_mutex_init(&new_heap->shards[i].lock, NULL);
+		new_heap->shards[i].heap = bh_initHeap(compare);
+	}
+	new_heap->comparefunction = compare;
+	new_heap->size = 0;
+	new_heap->waiting = 0;
+	new_heap->closed = false;
+	pthread_mutex_init(&new_heap->wait_lock, NULL);
+	pthread_cond_init(&new_heap->not_empty, NULL);
+	return new_heap;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di elementi contenuti nella struttura.
+ * In presenza di accessi concorrenti il valore è indicativo, poiché può cambiare subito dopo la lettura.
+ */
+int ch_getHeapSize(concurrentheap* h) {
+	return __atomic_load_n(&h->size, __ATOMIC_SEQ_CST);
+}
+
+// Cancelling Heap
+
+/**
+ * Libera la memoria occupata dagli shard e dalla struttura. Se "purge" è vero, vengono liberati anche gli elementi.
+ */
+static void ch_freeHeap(concurrentheap* h, bool purge) {
+	for (int i = 0; i < h->shards_number; i++) {
+		pthread_mutex_destroy(&h->shards[i].lock);
+		if (purge) {
+			bh_purgeHeap(h->shards[i].heap);
+		} else {
+			bh_deleteHeap(h->shards[i].heap);
+		}
+	}
+	pthread_mutex_destroy(&h->wait_lock);
+	pthread_cond_destroy(&h->not_empty);
+	free(h->shards);
+	free(h);
+}
+
+/**
+ * Elimina la struttura, senza eliminare gli oggetti contenuti in essa.
+ * <i>NOTA:</i> Nessun thread deve accedere alla struttura durante o dopo la chiamata a questa funzione.
+ */
+void ch_deleteHeap(concurrentheap* h) {
+	ch_freeHeap(h, false);
+}
+
+/**
+ * Elimina la struttura e gli oggetti contenuti in essa.
+ * <i>NOTA:</i> Nessun thread deve accedere alla struttura durante o dopo la chiamata a questa funzione.
+ */
+void ch_purgeHeap(concurrentheap* h) {
+	ch_freeHeap(h, true);
+}
+
+/**
+ * Chiude la struttura, risvegliando tutti i thread in attesa su "ch_waitAndExtractRootElement".
+ * Dopo la chiusura le estrazioni bloccanti restituiscono NULL non appena la struttura risulta vuota.
+ */
+void ch_closeHeap(concurrentheap* h) {
+	pthread_mutex_lock(&h->wait_lock);
+	h->closed = true;
+	pthread_cond_broadcast(&h->not_empty);
+	pthread_mutex_unlock(&h->wait_lock);
+}
+
+// Inserting Elements
+
+/**
+ * Inserisce un elemento nella struttura, all'interno del primo shard casuale che risulti libero.
+ * Se dopo un numero di tentativi pari al doppio degli shard non ne è stato trovato uno libero, il thread si blocca
+ * sul lock dell'ultimo shard scelto, invece di continuare a consumare CPU (ad esempio quando i thread sono più
+ * degli shard, o quando il thread che detiene il lock non è in esecuzione).
+ * Se ci sono thread in attesa di un elemento, ne viene risvegliato uno.
+ */
+void ch_insertElement(concurrentheap* h, void* new_element) {
+	int i = ch_getRandomShard(h);
+	for (int attempt = 1; pthread_mutex_trylock(&h->shards[i].lock) != 0; attempt++) {
+		if (attempt >= h->shards_number * 2) {
+			pthread_mutex_lock(&h->shards[i].lock);
+			break;
+		}
+		i = ch_getRandomShard(h);
+	}
+	bh_insertElement(h->shards[i].heap, new_element);
+	pthread_mutex_unlock(&h->shards[i].lock);
+	__atomic_add_fetch(&h->size, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&h->waiting, __ATOMIC_SEQ_CST) > 0) {
+		pthread_mutex_lock(&h->wait_lock);
+		pthread_cond_signal(&h->not_empty);
+		pthread_mutex_unlock(&h->wait_lock);
+	}
+}
+
+// Extracting Elements
+
+/**
+ * Estrae un elemento dalla struttura senza bloccarsi in attesa di nuovi inserimenti.
+ * L'elemento estratto è il maggiore fra le radici di due shard scelti a caso (vedi la nota sull'ordinamento rilassato).
+ * Se la struttura è vuota, restituisce NULL.
+ */
+void* ch_extractRootElement(concurrentheap* h) {
+	while (__atomic_load_n(&h->size, __ATOMIC_SEQ_CST) > EMPTY_SIZE) {
+		void* extracted = NULL;
+		for (int attempt = 0; attempt < h->shards_number * 2 && !extracted; attempt++) {
+			extracted = ch_tryExtractFromShards(h, ch_getRandomShard(h), ch_getRandomShard(h));
+		}
+		if (!extracted) {
+			extracted = ch_scanAndExtract(h);
+		}
+		if (extracted) {
+			__atomic_sub_fetch(&h->size, 1, __ATOMIC_SEQ_CST);
+			return extracted;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Estrae un elemento dalla struttura, attendendo che ne venga inserito uno se questa è vuota.
+ * Restituisce NULL solamente se la struttura è stata chiusa con "ch_closeHeap" ed è vuota.
+ */
+void* ch_waitAndExtractRootElement(concurrentheap* h) {
+	while (true) {
+		void* extracted = ch_extractRootElement(h);
+		if (extracted) {
+			return extracted;
+		}
+		pthread_mutex_lock(&h->wait_lock);
+		__atomic_add_fetch(&h->waiting, 1, __ATOMIC_SEQ_CST);
+		while (__atomic_load_n(&h->size, __ATOMIC_SEQ_CST) == EMPTY_SIZE && !h->closed) {
+			pthread_cond_wait(&h->not_empty, &h->wait_lock);
+		}
+		__atomic_sub_fetch(&h->waiting, 1, __ATOMIC_SEQ_CST);
+		bool closed = h->closed;
+		pthread_mutex_unlock(&h->wait_lock);
+		if (closed && __atomic_load_n(&h->size, __ATOMIC_SEQ_CST) == EMPTY_SIZE) {
+			return NULL;
+		}
+	}
+}
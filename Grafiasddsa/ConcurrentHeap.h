@@ -0,0 +1,46 @@
+#ifndef CONCURRENTHEAP_H_
+#define CONCURRENTHEAP_H_
+
+#include <pthread.h>
+
+#include "Heap.h"
+
+#ifndef CACHE_LINE_SIZE
+#	define CACHE_LINE_SIZE 64
+#endif
+
+typedef struct concurrentheap_shard {
+	pthread_mutex_t lock;
+	binaryheap* heap;
+} __attribute__((aligned(CACHE_LINE_SIZE))) concurrentheap_shard;
+
+typedef struct concurrentheap {
+	int shards_number;
+	concurrentheap_shard* shards;
+	int (*comparefunction)(void*, void*);
+	int size;
+	int waiting;
+	bool closed;
+	pthread_mutex_t wait_lock;
+	pthread_cond_t not_empty;
+} concurrentheap;
+
+// Initializing Heap
+concurrentheap* ch_initHeap(int (*compare)(void*, void*), int shards_number); // OK
+
+// Size
+int ch_getHeapSize(concurrentheap* h); // OK
+
+// Cancelling Heap
+void ch_deleteHeap(concurrentheap* h); // OK
+void ch_purgeHeap(concurrentheap* h); // OK
+void ch_closeHeap(concurrentheap* h); // OK
+
+// Inserting Elements
+void ch_insertElement(concurrentheap* h, void* new_element); // OK
+
+// Extracting Elements
+void* ch_extractRootElement(concurrentheap* h); // OK
+void* ch_waitAndExtractRootElement(concurrentheap* h); // OK
+
+#endif
@@ -1,7 +1,1544 @@
+// Necessario per "madvise" e "MAP_POPULATE", non definiti dallo standard C
+#define _DEFAULT_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Graph.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef INVALID_VERTEX_ERROR
+#	define INVALID_VERTEX_ERROR(instr, vertex) printf("Error: Invalid vertex %d in \"%s\" function.\n", vertex, instr )
+#endif
+
+#ifndef FILE_ERROR
+#	define FILE_ERROR(instr, path) printf("Error: Cannot access file \"%s\" in \"%s\" function.\n", path, instr )
+#endif
+
+#define DEFAULT_WEIGHT 1.0
+#define DEFAULT_VERTICES_CAPACITY 16
+#define INDEX_DEGREE_THRESHOLD 16
+#define INDEX_INITIAL_CAPACITY 64
+#define INDEX_EMPTY_KEY (-1)
+
+#define GRAPH_FILE_MAGIC "GRAFCSR"
+#define GRAPH_FILE_VERSION 1
+#define GRAPH_FILE_BYTE_ORDER 0x01020304u
+#define GRAPH_FILE_ALIGNMENT 64
+#define GRAPH_FILE_DIRECTED 1u
+#define GRAPH_FILE_WEIGHTED 2u
 
+#define CGRAPH_ANCHOR_SHIFT 6
+#define CGRAPH_INITIAL_DATA_CAPACITY 64
+#define CGRAPH_INITIAL_ROW_CAPACITY 16
+#define CGRAPH_MAX_VARINT_SIZE 5
+
+/**
+ * Libreria che permette la creazione e gestione di un grafo statico, memorizzato in formato CSR
+ * ("compressed sparse row").
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * I vertici sono identificati dagli interi da 0 a (vertices_number - 1). Gli archi uscenti da ogni vertice sono
+ * memorizzati in modo contiguo all'interno di un unico array "neighbors": gli archi uscenti dal vertice [v] occupano
+ * le posizioni da offsets[v] (incluso) a offsets[v + 1] (escluso). L'array "offsets" ha quindi (vertices_number + 1)
+ * elementi. Se il grafo è pesato, l'array "weights" è parallelo a "neighbors"; altrimenti vale NULL, e tutti gli archi
+ * hanno peso unitario.
+ *
+ * La struttura occupa (vertices_number + 1) long e un int (più un double, se pesato) per ogni arco memorizzato,
+ * senza alcuna allocazione per singolo arco: la visita dei vicini di un vertice consiste nello scorrere una porzione
+ * contigua di array (vedi "gr_getNeighbors").
+ *
+ * <i>NOTA:</i> In un grafo non orientato ogni arco {u, v} viene memorizzato in entrambe le direzioni, tranne
+ * i cappi {v, v} che vengono memorizzati una volta sola. Per questo motivo si distingue fra il numero di archi
+ * forniti in fase di costruzione ("gr_getEdgesNumber") e il numero di archi memorizzati ("gr_getArcsNumber").
+ *
+ * Il grafo dinamico (dgraph) è invece pensato per gli aggiornamenti continui: ogni vertice mantiene i propri vicini
+ * in un arraylist (creato al primo arco), in cui il vertice di destinazione è memorizzato direttamente nel puntatore,
+ * senza allocazioni per singolo arco. Se il grafo è pesato, un secondo arraylist parallelo contiene i pesi (anch'essi
+ * memorizzati direttamente nel puntatore). L'aggiunta di un arco costa O(1) ammortizzato; la cancellazione sposta
+ * l'ultimo arco del vertice nella posizione liberata ("swap-remove"), e costa O(1) più il costo della ricerca.
+ * Se il grafo è inizializzato con l'opzione "indexed", i vertici il cui grado supera INDEX_DEGREE_THRESHOLD
+ * mantengono anche un indice hash (ad indirizzamento aperto) dalla destinazione alla posizione dell'arco, e la
+ * ricerca costa O(1) atteso; altrimenti la ricerca scorre i vicini del vertice.
+ * Al termine della fase di aggiornamento, il grafo può essere convertito in formato CSR con "dgr_freezeGraph".
+ *
+ * Il grafo CSR può essere salvato su file in formato binario ("gr_saveGraph") e ricaricato mappando il file in
+ * memoria ("gr_loadGraph"), senza alcuna lettura né copia: gli array del grafo puntano direttamente alla mappatura.
+ * Il file è composto da un'intestazione (graph_file_header) seguita dagli array "offsets", "neighbors" e (se il grafo
+ * è pesato) "weights", ciascuno allineato a GRAPH_FILE_ALIGNMENT byte e memorizzato nella rappresentazione nativa
+ * della macchina; l'intestazione contiene un numero di versione e un marcatore dell'ordine dei byte, che vengono
+ * verificati al caricamento.
+ *
+ * Il grafo compresso (cgraph) è una versione in sola lettura del grafo CSR che occupa meno memoria, pensata per i
+ * grafi che non entrano in memoria nel formato CSR (i pesi non vengono memorizzati). La lista dei vicini di ogni
+ * vertice viene ordinata e codificata come sequenza di differenze ("gap") fra vicini consecutivi, ciascuna scritta
+ * come intero a lunghezza variabile (varint: 7 bit per byte, con il bit più significativo che indica la presenza di
+ * un byte successivo). La lista inizia con il grado del vertice e con la differenza fra il primo vicino e il vertice
+ * stesso, con segno (codificata "zigzag": 0, -1, 1, -2, ... diventano 0, 1, 2, 3, ...).
+ * La posizione in byte della lista di ogni vertice nell'array "data" è memorizzata in due livelli: i vertici sono
+ * raggruppati in blocchi di 2^CGRAPH_ANCHOR_SHIFT righe consecutive, l'array "anchors" contiene la posizione (a 64 bit)
+ * dell'inizio di ogni blocco e l'array "offsets" la posizione (a 32 bit) di ogni riga relativa al proprio blocco.
+ * In questo modo gli offset occupano poco più di 4 byte per vertice, invece degli 8 byte del formato CSR.
+ * Se gli indici dei vicini sono vicini fra loro (ad esempio dopo un riordinamento con GraphOrdering), la maggior
+ * parte delle differenze occupa un solo byte, invece dei 4 byte del formato CSR. I vicini si leggono decodificando
+ * la lista in sequenza, con un iteratore ("cgr_nextNeighbor") o in blocco in un array ("cgr_getNeighbors").
+ * Il grafo compresso può essere costruito senza passare dal grafo CSR, con un costruttore incrementale
+ * ("cgraph_builder") che riceve gli archi ordinati per vertice sorgente e codifica ogni riga non appena è completa:
+ * la memoria richiesta è quella del grafo compresso più la riga corrente ("cgr_loadEdgeList" lo utilizza per leggere
+ * una lista di archi da file).
+ */
+
+/*
 typedef struct graph {
-	
+	int vertices_number;
+	long edges_number;
+	bool directed;
+	long* offsets;
+	int* neighbors;
+	double* weights;
+	void* mapping;
+	size_t mapping_size;
 } graph;
+
+typedef struct dgraph_index {
+	int capacity;
+	int size;
+	int* keys;
+	int* positions;
+} dgraph_index;
+
+typedef struct dgraph_vertex {
+	arraylist* neighbors;
+	arraylist* weights;
+	dgraph_index* index;
+} dgraph_vertex;
+
+typedef struct dgraph {
+	int vertices_number;
+	int vertices_capacity;
+	long edges_number;
+	bool directed;
+	bool weighted;
+	bool indexed;
+	dgraph_vertex* vertices;
+} dgraph;
+
+typedef struct cgraph {
+	int vertices_number;
+	long edges_number;
+	bool directed;
+	int max_degree;
+	long* anchors;
+	uint32_t* offsets;
+	unsigned char* data;
+} cgraph;
+
+typedef struct cgraph_iterator {
+	const unsigned char* position;
+	int remaining;
+	int current;
+	bool started;
+} cgraph_iterator;
+
+typedef struct cgraph_builder {
+	cgraph* graph;
+	long data_size;
+	long data_capacity;
+	long arcs_number;
+	int current_vertex;
+	int* row;
+	int row_size;
+	int row_capacity;
+} cgraph_builder;
+*/
+
+_Static_assert(sizeof(double) <= sizeof(void*), "Weights are stored directly inside arraylist pointers");
+_Static_assert(sizeof(long) == sizeof(int64_t), "Offsets are stored on file as 64-bit integers");
+
+/**
+ * Intestazione del formato binario su file. Tutte le posizioni sono espresse in byte dall'inizio del file.
+ */
+typedef struct graph_file_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t flags;
+	uint32_t reserved;
+	int64_t vertices_number;
+	int64_t edges_number;
+	int64_t arcs_number;
+	uint64_t offsets_position;
+	uint64_t neighbors_position;
+	uint64_t weights_position;
+	uint64_t file_size;
+} graph_file_header;
+
+// Static Utility Functions
+
+/**
+ * Restituisce true se il vertice appartiene al grafo.
+ */
+static bool gr_isValidVertex(graph* g, int vertex) {
+	return vertex >= 0 && vertex < g->vertices_number;
+}
+
+/**
+ * Colloca un arco nella prima posizione libera del vertice sorgente.
+ * Durante la costruzione offsets[v] viene utilizzato come cursore, e al termine indica la fine della riga di [v].
+ */
+static void gr_placeArc(graph* g, int source, int destination, double* weights, long edge) {
+	long arc = g->offsets[source]++;
+	g->neighbors[arc] = destination;
+	if (weights) {
+		g->weights[arc] = weights[edge];
+	}
+}
+
+static bool dgr_isValidVertex(dgraph* g, int vertex) {
+	return vertex >= 0 && vertex < g->vertices_number;
+}
+
+/**
+ * Funzioni di codifica dei vertici e dei pesi all'interno dei puntatori degli arraylist.
+ */
+static void* dgr_encodeVertex(int vertex) {
+	return (void*)(intptr_t)vertex;
+}
+
+static int dgr_decodeVertex(void* element) {
+	return (int)(intptr_t)element;
+}
+
+static void* dgr_encodeWeight(double weight) {
+	void* element = NULL;
+	memcpy(&element, &weight, sizeof(double));
+	return element;
+}
+
+static double dgr_decodeWeight(void* element) {
+	double weight;
+	memcpy(&weight, &element, sizeof(double));
+	return weight;
+}
+
+/**
+ * Funzione di hash per l'indice dei vicini. La capacità dell'indice è sempre una potenza di 2.
+ */
+static int dgr_hashVertex(int vertex, int capacity) {
+	uint32_t hash = (uint32_t)vertex * 0x9E3779B1u;
+	return (int)((hash ^ (hash >> 16)) & (uint32_t)(capacity - 1));
+}
+
+static dgraph_index* dgr_initIndex(int capacity) {
+	dgraph_index* new_index = malloc(sizeof(dgraph_index));
+	if (!new_index) {
+		MEMORY_ERROR;
+	}
+	new_index->capacity = capacity;
+	new_index->size = 0;
+	new_index->keys = malloc(capacity * sizeof(int));
+	new_index->positions = malloc(capacity * sizeof(int));
+	if (!new_index->keys || !new_index->positions) {
+		MEMORY_ERROR;
+	}
+	for (int i = 0; i < capacity; i++) {
+		new_index->keys[i] = INDEX_EMPTY_KEY;
+	}
+	return new_index;
+}
+
+static void dgr_deleteIndex(dgraph_index* index) {
+	if (index) {
+		free(index->keys);
+		free(index->positions);
+		free(index);
+	}
+}
+
+/**
+ * Inserisce nell'indice la coppia (destinazione, posizione), senza controllarne la capienza.
+ * Poiché il grafo ammette archi multipli, la stessa chiave può comparire più volte con posizioni diverse.
+ */
+static void dgr_placeInIndex(dgraph_index* index, int key, int position) {
+	int slot = dgr_hashVertex(key, index->capacity);
+	while (index->keys[slot] != INDEX_EMPTY_KEY) {
+		slot = (slot + 1) & (index->capacity - 1);
+	}
+	index->keys[slot] = key;
+	index->positions[slot] = position;
+	index->size++;
+}
+
+/**
+ * Inserisce nell'indice la coppia (destinazione, posizione), raddoppiandone la capacità quando
+ * il fattore di carico supera 1/2.
+ */
+static void dgr_insertIntoIndex(dgraph_index* index, int key, int position) {
+	if ((index->size + 1) * 2 > index->capacity) {
+		dgraph_index* larger = dgr_initIndex(index->capacity * 2);
+		for (int i = 0; i < index->capacity; i++) {
+			if (index->keys[i] != INDEX_EMPTY_KEY) {
+				dgr_placeInIndex(larger, index->keys[i], index->positions[i]);
+			}
+		}
+		free(index->keys);
+		free(index->positions);
+		*index = *larger;
+		free(larger);
+	}
+	dgr_placeInIndex(index, key, position);
+}
+
+/**
+ * Restituisce lo slot dell'indice che contiene la chiave data associata alla posizione data
+ * (o ad una posizione qualsiasi, se "position" è negativa), oppure -1 se assente.
+ */
+static int dgr_findInIndex(dgraph_index* index, int key, int position) {
+	int slot = dgr_hashVertex(key, index->capacity);
+	while (index->keys[slot] != INDEX_EMPTY_KEY) {
+		if (index->keys[slot] == key && (position < 0 || index->positions[slot] == position)) {
+			return slot;
+		}
+		slot = (slot + 1) & (index->capacity - 1);
+	}
+	return -1;
+}
+
+/**
+ * Rimuove uno slot dall'indice. Per non lasciare "buchi" nelle sequenze di scansione, gli elementi successivi
+ * vengono fatti arretrare nel buco se questo si trova fra la loro posizione naturale e quella attuale.
+ */
+static void dgr_removeFromIndex(dgraph_index* index, int slot) {
+	int mask = index->capacity - 1;
+	int hole = slot;
+	int next = (hole + 1) & mask;
+	while (index->keys[next] != INDEX_EMPTY_KEY) {
+		int home = dgr_hashVertex(index->keys[next], index->capacity);
+		if (((next - home) & mask) >= ((next - hole) & mask)) {
+			index->keys[hole] = index->keys[next];
+			index->positions[hole] = index->positions[next];
+			hole = next;
+		}
+		next = (next + 1) & mask;
+	}
+	index->keys[hole] = INDEX_EMPTY_KEY;
+	index->size--;
+}
+
+/**
+ * Costruisce l'indice dei vicini di un vertice, a partire dal suo arraylist.
+ */
+static void dgr_buildIndex(dgraph_vertex* v) {
+	int capacity = INDEX_INITIAL_CAPACITY;
+	while (capacity < v->neighbors->size * 2) {
+		capacity *= 2;
+	}
+	v->index = dgr_initIndex(capacity);
+	for (int i = 0; i < v->neighbors->size; i++) {
+		dgr_placeInIndex(v->index, dgr_decodeVertex(v->neighbors->array[i]), i);
+	}
+}
+
+/**
+ * Aggiunge un arco in coda ai vicini del vertice sorgente, aggiornando l'eventuale indice.
+ */
+static void dgr_appendArc(dgraph* g, int source, int destination, double weight) {
+	dgraph_vertex* v = &g->vertices[source];
+	if (!v->neighbors) {
+		v->neighbors = al_initList();
+		if (g->weighted) {
+			v->weights = al_initList();
+		}
+	}
+	al_insertLastElement(v->neighbors, dgr_encodeVertex(destination));
+	if (v->weights) {
+		al_insertLastElement(v->weights, dgr_encodeWeight(weight));
+	}
+	if (v->index) {
+		dgr_insertIntoIndex(v->index, destination, v->neighbors->size - 1);
+	} else if (g->indexed && v->neighbors->size >= INDEX_DEGREE_THRESHOLD) {
+		dgr_buildIndex(v);
+	}
+}
+
+/**
+ * Restituisce la posizione di un arco fra i vicini del vertice sorgente, oppure -1 se assente.
+ */
+static int dgr_findArc(dgraph_vertex* v, int destination) {
+	if (!v->neighbors) {
+		return -1;
+	}
+	if (v->index) {
+		int slot = dgr_findInIndex(v->index, destination, -1);
+		return slot < 0 ? -1 : v->index->positions[slot];
+	}
+	for (int i = 0; i < v->neighbors->size; i++) {
+		if (dgr_decodeVertex(v->neighbors->array[i]) == destination) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+ * Rimuove un arco dai vicini del vertice sorgente, spostando l'ultimo arco nella posizione liberata.
+ * Restituisce false se l'arco non è presente.
+ */
+static bool dgr_removeArc(dgraph* g, int source, int destination) {
+	dgraph_vertex* v = &g->vertices[source];
+	int position = dgr_findArc(v, destination);
+	if (position < 0) {
+		return false;
+	}
+	int last = v->neighbors->size - 1;
+	if (v->index) {
+		dgr_removeFromIndex(v->index, dgr_findInIndex(v->index, destination, position));
+	}
+	if (position != last) {
+		void* moved = v->neighbors->array[last];
+		v->neighbors->array[position] = moved;
+		if (v->weights) {
+			v->weights->array[position] = v->weights->array[last];
+		}
+		if (v->index) {
+			v->index->positions[dgr_findInIndex(v->index, dgr_decodeVertex(moved), last)] = position;
+		}
+	}
+	al_deleteLastElement(v->neighbors);
+	if (v->weights) {
+		al_deleteLastElement(v->weights);
+	}
+	return true;
+}
+
+/**
+ * Scrive un intero senza segno come varint a partire dalla posizione data, e restituisce la posizione successiva.
+ * Se "data" è NULL, restituisce solamente la posizione successiva (per calcolare la lunghezza della codifica).
+ */
+static long cgr_writeVarint(unsigned char* data, long position, uint32_t value) {
+	while (value >= 0x80) {
+		if (data) {
+			data[position] = (unsigned char)(value | 0x80);
+		}
+		position++;
+		value >>= 7;
+	}
+	if (data) {
+		data[position] = (unsigned char)value;
+	}
+	return position + 1;
+}
+
+/**
+ * Legge un varint a partire dal puntatore dato, facendolo avanzare oltre la codifica.
+ * Il caso di un solo byte, il più frequente, viene gestito separatamente.
+ */
+static uint32_t cgr_readVarint(const unsigned char** position) {
+	const unsigned char* p = *position;
+	uint32_t value = *p++;
+	if (value >= 0x80) {
+		value &= 0x7f;
+		int shift = 7;
+		unsigned char byte;
+		do {
+			byte = *p++;
+			value |= (uint32_t)(byte & 0x7f) << shift;
+			shift += 7;
+		} while (byte >= 0x80);
+	}
+	*position = p;
+	return value;
+}
+
+/**
+ * Codifica "zigzag" di un intero con segno: i valori di modulo piccolo (positivi o negativi) restano piccoli.
+ */
+static uint32_t cgr_zigzagEncode(int64_t value) {
+	return (uint32_t)(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/**
+ * Decodifica "zigzag", inversa di "cgr_zigzagEncode".
+ */
+static int64_t cgr_zigzagDecode(uint32_t value) {
+	return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+/**
+ * Confronta due interi, per l'ordinamento delle liste di vicini.
+ */
+static int cgr_compareInts(const void* first, const void* second) {
+	int a = *(const int*)first;
+	int b = *(const int*)second;
+	return (a > b) - (a < b);
+}
+
+/**
+ * Restituisce la posizione in byte della lista di un vertice nell'array "data" del grafo compresso, sommando l'ancora
+ * del blocco e l'offset relativo. Il vertice può essere anche pari al numero di vertici (fine dell'ultima lista).
+ */
+static inline long cgr_getDataPosition(cgraph* g, int vertex) {
+	return g->anchors[vertex >> CGRAPH_ANCHOR_SHIFT] + g->offsets[vertex];
+}
+
+/**
+ * Codifica la lista (ordinata) dei vicini di un vertice a partire dalla posizione data, e restituisce la posizione
+ * successiva. Se "data" è NULL, calcola solamente la lunghezza della codifica.
+ */
+static long cgr_encodeNeighbors(unsigned char* data, long position, int vertex, int* neighbors, int degree) {
+	position = cgr_writeVarint(data, position, (uint32_t)degree);
+	for (int i = 0; i < degree; i++) {
+		uint32_t gap = i == 0 ? cgr_zigzagEncode((int64_t)neighbors[0] - vertex)
+			: (uint32_t)(neighbors[i] - neighbors[i - 1]);
+		position = cgr_writeVarint(data, position, gap);
+	}
+	return position;
+}
+
+// Initializing Graph
+
+/**
+ * Costruisce un grafo a partire da una lista di archi, fornita come coppia di array paralleli "sources" e
+ * "destinations" di lunghezza "edges_number". L'array "weights" (anch'esso parallelo) è opzionale: se NULL,
+ * il grafo non è pesato. Gli array vengono solamente letti, e rimangono di proprietà del chiamante.
+ *
+ * La costruzione avviene in tempo O(V + E) mediante counting sort sui vertici sorgente: si contano gli archi uscenti
+ * da ogni vertice, si calcolano le somme prefisse (che diventano gli offset) e si collocano gli archi nelle rispettive
+ * righe. L'ordine dei vicini di ogni vertice rispetta l'ordine della lista di archi.
+ *
+ * Se un arco fa riferimento ad un vertice non valido, viene stampato un errore e restituito NULL.
+ */
+graph* gr_initGraphFromEdges(int vertices_number, long edges_number, int* sources, int* destinations,
+		double* weights, bool directed) {
+	for (long i = 0; i < edges_number; i++) {
+		if (sources[i] < 0 || sources[i] >= vertices_number) {
+			INVALID_VERTEX_ERROR("gr_initGraphFromEdges", sources[i]);
+			return NULL;
+		}
+		if (destinations[i] < 0 || destinations[i] >= vertices_number) {
+			INVALID_VERTEX_ERROR("gr_initGraphFromEdges", destinations[i]);
+			return NULL;
+		}
+	}
+	graph* new_graph = malloc(sizeof(graph));
+	if (!new_graph) {
+		MEMORY_ERROR;
+	}
+	new_graph->vertices_number = vertices_number;
+	new_graph->edges_number = edges_number;
+	new_graph->directed = directed;
+	new_graph->mapping = NULL;
+	new_graph->mapping_size = 0;
+	new_graph->offsets = calloc((size_t)vertices_number + 1, sizeof(long));
+	if (!new_graph->offsets) {
+		MEMORY_ERROR;
+	}
+	// Conteggio degli archi uscenti da ogni vertice, memorizzato in offsets[v + 1]
+	for (long i = 0; i < edges_number; i++) {
+		new_graph->offsets[sources[i] + 1]++;
+		if (!directed && sources[i] != destinations[i]) {
+			new_graph->offsets[destinations[i] + 1]++;
+		}
+	}
+	// Somme prefisse: offsets[v] diventa l'inizio della riga di [v]
+	for (int v = 0; v < vertices_number; v++) {
+		new_graph->offsets[v + 1] += new_graph->offsets[v];
+	}
+	long arcs_number = new_graph->offsets[vertices_number];
+	new_graph->neighbors = malloc((size_t)arcs_number * sizeof(int) + 1);
+	new_graph->weights = weights ? malloc((size_t)arcs_number * sizeof(double) + 1) : NULL;
+	if (!new_graph->neighbors || (weights && !new_graph->weights)) {
+		MEMORY_ERROR;
+	}
+	// Collocazione degli archi, utilizzando gli offset come cursori
+	for (long i = 0; i < edges_number; i++) {
+		gr_placeArc(new_graph, sources[i], destinations[i], weights, i);
+		if (!directed && sources[i] != destinations[i]) {
+			gr_placeArc(new_graph, destinations[i], sources[i], weights, i);
+		}
+	}
+	// Al termine offsets[v] indica la fine della riga di [v]: riporto gli offset all'inizio delle righe
+	memmove(new_graph->offsets + 1, new_graph->offsets, (size_t)vertices_number * sizeof(long));
+	new_graph->offsets[0] = 0;
+	return new_graph;
+}
+
+/**
+ * Inizializza un grafo dinamico con il numero di vertici indicato (eventualmente nullo) e nessun arco.
+ * Se "indexed" è vero, i vertici di grado elevato mantengono un indice hash dei propri vicini, che rende
+ * la ricerca e la cancellazione degli archi O(1) attese al prezzo di memoria aggiuntiva.
+ */
+dgraph* dgr_initGraph(int vertices_number, bool directed, bool weighted, bool indexed) {
+	dgraph* new_graph = malloc(sizeof(dgraph));
+	if (!new_graph) {
+		MEMORY_ERROR;
+	}
+	new_graph->vertices_number = vertices_number;
+	new_graph->vertices_capacity = vertices_number > DEFAULT_VERTICES_CAPACITY ? vertices_number : DEFAULT_VERTICES_CAPACITY;
+	new_graph->edges_number = 0;
+	new_graph->directed = directed;
+	new_graph->weighted = weighted;
+	new_graph->indexed = indexed;
+	new_graph->vertices = calloc(new_graph->vertices_capacity, sizeof(dgraph_vertex));
+	if (!new_graph->vertices) {
+		MEMORY_ERROR;
+	}
+	return new_graph;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di vertici del grafo.
+ */
+int gr_getVerticesNumber(graph* g) {
+	return g->vertices_number;
+}
+
+/**
+ * Restituisce il numero di archi forniti in fase di costruzione.
+ */
+long gr_getEdgesNumber(graph* g) {
+	return g->edges_number;
+}
+
+/**
+ * Restituisce il numero di archi effettivamente memorizzati, ossia la lunghezza dell'array "neighbors".
+ * Per un grafo orientato coincide con il numero di archi; per un grafo non orientato ogni arco (tranne i cappi)
+ * viene contato due volte.
+ */
+long gr_getArcsNumber(graph* g) {
+	return g->offsets[g->vertices_number];
+}
+
+/**
+ * Restituisce true se il grafo è orientato.
+ */
+bool gr_isDirected(graph* g) {
+	return g->directed;
+}
+
+/**
+ * Restituisce true se il grafo è pesato.
+ */
+bool gr_isWeighted(graph* g) {
+	return g->weights != NULL;
+}
+
+/**
+ * Restituisce il numero di vertici del grafo dinamico.
+ */
+int dgr_getVerticesNumber(dgraph* g) {
+	return g->vertices_number;
+}
+
+/**
+ * Restituisce il numero di archi del grafo dinamico (per un grafo non orientato, ogni arco è contato una volta).
+ */
+long dgr_getEdgesNumber(dgraph* g) {
+	return g->edges_number;
+}
+
+/**
+ * Restituisce il numero di vertici del grafo compresso.
+ */
+int cgr_getVerticesNumber(cgraph* g) {
+	return g->vertices_number;
+}
+
+/**
+ * Restituisce il numero di archi del grafo compresso (contati come nel grafo CSR da cui è stato ottenuto).
+ */
+long cgr_getEdgesNumber(cgraph* g) {
+	return g->edges_number;
+}
+
+/**
+ * Restituisce la memoria occupata dagli array del grafo, in byte.
+ */
+size_t gr_getMemorySize(graph* g) {
+	size_t arcs_number = (size_t)g->offsets[g->vertices_number];
+	return ((size_t)g->vertices_number + 1) * sizeof(long) + arcs_number * sizeof(int)
+		+ (g->weights ? arcs_number * sizeof(double) : 0);
+}
+
+/**
+ * Restituisce la memoria occupata dagli array del grafo compresso, in byte.
+ */
+size_t cgr_getMemorySize(cgraph* g) {
+	size_t anchors_number = ((size_t)g->vertices_number >> CGRAPH_ANCHOR_SHIFT) + 1;
+	return ((size_t)g->vertices_number + 1) * sizeof(uint32_t) + anchors_number * sizeof(long)
+		+ (size_t)cgr_getDataPosition(g, g->vertices_number);
+}
+
+// Cancelling Graph
+
+/**
+ * Elimina il grafo, ripulendo la memoria occupata da tutti i suoi array.
+ * Se il grafo è stato caricato con "gr_loadGraph", viene invece rimossa la mappatura del file.
+ */
+void gr_deleteGraph(graph* g) {
+	if (g->mapping) {
+		munmap(g->mapping, g->mapping_size);
+	} else {
+		free(g->offsets);
+		free(g->neighbors);
+		free(g->weights);
+	}
+	free(g);
+}
+
+/**
+ * Elimina il grafo dinamico, ripulendo la memoria occupata dalle liste dei vicini e dagli indici.
+ */
+void dgr_deleteGraph(dgraph* g) {
+	for (int v = 0; v < g->vertices_number; v++) {
+		if (g->vertices[v].neighbors) {
+			al_deleteList(g->vertices[v].neighbors);
+		}
+		if (g->vertices[v].weights) {
+			al_deleteList(g->vertices[v].weights);
+		}
+		dgr_deleteIndex(g->vertices[v].index);
+	}
+	free(g->vertices);
+	free(g);
+}
+
+/**
+ * Elimina il grafo compresso, ripulendo la memoria occupata dai suoi array.
+ */
+void cgr_deleteGraph(cgraph* g) {
+	free(g->anchors);
+	free(g->offsets);
+	free(g->data);
+	free(g);
+}
+
+// Updating Graph
+
+/**
+ * Aggiunge un nuovo vertice (isolato) al grafo dinamico, in tempo O(1) ammortizzato, e ne restituisce l'identificativo.
+ */
+int dgr_addVertex(dgraph* g) {
+	if (g->vertices_number == g->vertices_capacity) {
+		g->vertices_capacity *= 2;
+		g->vertices = realloc(g->vertices, g->vertices_capacity * sizeof(dgraph_vertex));
+		if (!g->vertices) {
+			MEMORY_ERROR;
+		}
+	}
+	dgraph_vertex* new_vertex = &g->vertices[g->vertices_number];
+	new_vertex->neighbors = NULL;
+	new_vertex->weights = NULL;
+	new_vertex->index = NULL;
+	return g->vertices_number++;
+}
+
+/**
+ * Aggiunge un arco al grafo dinamico, in tempo O(1) ammortizzato. Il peso viene ignorato se il grafo non è pesato.
+ * Gli archi multipli sono ammessi; in un grafo non orientato l'arco viene aggiunto in entrambe le direzioni.
+ */
+void dgr_addEdge(dgraph* g, int source, int destination, double weight) {
+	if (!dgr_isValidVertex(g, source) || !dgr_isValidVertex(g, destination)) {
+		INVALID_VERTEX_ERROR("dgr_addEdge", dgr_isValidVertex(g, source) ? destination : source);
+		return;
+	}
+	dgr_appendArc(g, source, destination, weight);
+	if (!g->directed && source != destination) {
+		dgr_appendArc(g, destination, source, weight);
+	}
+	g->edges_number++;
+}
+
+/**
+ * Cancella un arco (una sola occorrenza, se l'arco è multiplo) dal grafo dinamico.
+ * L'ultimo arco del vertice sorgente prende il posto di quello cancellato, quindi l'ordine dei vicini non viene
+ * mantenuto. Restituisce false se l'arco non è presente.
+ */
+bool dgr_deleteEdge(dgraph* g, int source, int destination) {
+	if (!dgr_isValidVertex(g, source) || !dgr_isValidVertex(g, destination)) {
+		INVALID_VERTEX_ERROR("dgr_deleteEdge", dgr_isValidVertex(g, source) ? destination : source);
+		return false;
+	}
+	if (!dgr_removeArc(g, source, destination)) {
+		return false;
+	}
+	if (!g->directed && source != destination) {
+		dgr_removeArc(g, destination, source);
+	}
+	g->edges_number--;
+	return true;
+}
+
+// Getting Neighbors
+
+/**
+ * Restituisce il numero di archi uscenti dal vertice (per un grafo non orientato, il numero di archi incidenti).
+ */
+int gr_getVertexDegree(graph* g, int vertex) {
+	if (!gr_isValidVertex(g, vertex)) {
+		INVALID_VERTEX_ERROR("gr_getVertexDegree", vertex);
+		return 0;
+	}
+	return (int)(g->offsets[vertex + 1] - g->offsets[vertex]);
+}
+
+/**
+ * Restituisce un puntatore al primo vicino del vertice all'interno dell'array "neighbors".
+ * I vicini sono i "gr_getVertexDegree(g, vertex)" interi consecutivi a partire dal puntatore restituito:
+ *
+ *	int* neighbors = gr_getNeighbors(g, v);
+ *	for (int i = 0; i < gr_getVertexDegree(g, v); i++) {
+ *		... neighbors[i] ...
+ *	}
+ *
+ * Il puntatore fa riferimento alla memoria interna del grafo, e non deve essere liberato né modificato.
+ */
+int* gr_getNeighbors(graph* g, int vertex) {
+	if (!gr_isValidVertex(g, vertex)) {
+		INVALID_VERTEX_ERROR("gr_getNeighbors", vertex);
+		return NULL;
+	}
+	return g->neighbors + g->offsets[vertex];
+}
+
+/**
+ * Restituisce un puntatore al peso del primo arco uscente dal vertice, parallelo a quello di "gr_getNeighbors".
+ * Se il grafo non è pesato, restituisce NULL (vedi "gr_getArcWeight").
+ */
+double* gr_getNeighborsWeights(graph* g, int vertex) {
+	if (!gr_isValidVertex(g, vertex)) {
+		INVALID_VERTEX_ERROR("gr_getNeighborsWeights", vertex);
+		return NULL;
+	}
+	return g->weights ? g->weights + g->offsets[vertex] : NULL;
+}
+
+/**
+ * Restituisce il peso dell'arco memorizzato alla posizione data dell'array "neighbors",
+ * oppure un peso unitario se il grafo non è pesato.
+ */
+double gr_getArcWeight(graph* g, long arc) {
+	return g->weights ? g->weights[arc] : DEFAULT_WEIGHT;
+}
+
+/**
+ * Restituisce il numero di archi uscenti dal vertice del grafo dinamico.
+ */
+int dgr_getVertexDegree(dgraph* g, int vertex) {
+	if (!dgr_isValidVertex(g, vertex)) {
+		INVALID_VERTEX_ERROR("dgr_getVertexDegree", vertex);
+		return 0;
+	}
+	return g->vertices[vertex].neighbors ? g->vertices[vertex].neighbors->size : 0;
+}
+
+/**
+ * Restituisce l'i-esimo vicino del vertice, con i compreso fra 0 e "dgr_getVertexDegree(g, vertex) - 1".
+ * <i>NOTA:</i> Le cancellazioni modificano l'ordine dei vicini.
+ */
+int dgr_getNeighbor(dgraph* g, int vertex, int i) {
+	return dgr_decodeVertex(g->vertices[vertex].neighbors->array[i]);
+}
+
+/**
+ * Restituisce il peso dell'arco verso l'i-esimo vicino del vertice, oppure un peso unitario se il grafo non è pesato.
+ */
+double dgr_getNeighborWeight(dgraph* g, int vertex, int i) {
+	return g->weighted ? dgr_decodeWeight(g->vertices[vertex].weights->array[i]) : DEFAULT_WEIGHT;
+}
+
+/**
+ * Restituisce il grado (uscente) di un vertice del grafo compresso, leggendo solamente l'inizio della sua lista.
+ */
+int cgr_getVertexDegree(cgraph* g, int vertex) {
+	if (vertex < 0 || vertex >= g->vertices_number) {
+		INVALID_VERTEX_ERROR("cgr_getVertexDegree", vertex);
+		return 0;
+	}
+	const unsigned char* position = g->data + cgr_getDataPosition(g, vertex);
+	return (int)cgr_readVarint(&position);
+}
+
+/**
+ * Decodifica i vicini di un vertice del grafo compresso nell'array dato (fornito dal chiamante, di lunghezza almeno
+ * pari al grado del vertice, o al campo "max_degree" del grafo), in ordine crescente, e ne restituisce il numero.
+ */
+int cgr_getNeighbors(cgraph* g, int vertex, int* neighbors) {
+	if (vertex < 0 || vertex >= g->vertices_number) {
+		INVALID_VERTEX_ERROR("cgr_getNeighbors", vertex);
+		return 0;
+	}
+	const unsigned char* position = g->data + cgr_getDataPosition(g, vertex);
+	int degree = (int)cgr_readVarint(&position);
+	if (degree > 0) {
+		int current = (int)(vertex + cgr_zigzagDecode(cgr_readVarint(&position)));
+		neighbors[0] = current;
+		for (int i = 1; i < degree; i++) {
+			current += (int)cgr_readVarint(&position);
+			neighbors[i] = current;
+		}
+	}
+	return degree;
+}
+
+/**
+ * Restituisce la posizione in byte della lista dei vicini di un vertice nell'array "data" del grafo compresso.
+ * È ammesso anche il vertice pari al numero di vertici, la cui posizione coincide con la dimensione dei dati:
+ * la differenza fra le posizioni di due vertici misura quindi la memoria occupata dalle righe comprese fra essi.
+ */
+long cgr_getRowPosition(cgraph* g, int vertex) {
+	if (vertex < 0 || vertex > g->vertices_number) {
+		INVALID_VERTEX_ERROR("cgr_getRowPosition", vertex);
+		return 0;
+	}
+	return cgr_getDataPosition(g, vertex);
+}
+
+/**
+ * Inizializza un iteratore sui vicini di un vertice del grafo compresso, da scorrere con "cgr_nextNeighbor".
+ * L'iteratore non alloca memoria, e può essere dichiarato sullo stack.
+ */
+void cgr_initIterator(cgraph* g, int vertex, cgraph_iterator* it) {
+	it->remaining = 0;
+	it->current = vertex;
+	it->started = false;
+	if (vertex < 0 || vertex >= g->vertices_number) {
+		INVALID_VERTEX_ERROR("cgr_initIterator", vertex);
+		return;
+	}
+	it->position = g->data + cgr_getDataPosition(g, vertex);
+	it->remaining = (int)cgr_readVarint(&it->position);
+}
+
+/**
+ * Scrive nel puntatore "neighbor" il prossimo vicino dell'iteratore, in ordine crescente.
+ * Restituisce false (senza modificare "neighbor") se i vicini sono terminati.
+ */
+bool cgr_nextNeighbor(cgraph_iterator* it, int* neighbor) {
+	if (it->remaining == 0) {
+		return false;
+	}
+	// Il primo vicino è codificato rispetto al vertice stesso, con segno; i successivi rispetto al precedente
+	uint32_t gap = cgr_readVarint(&it->position);
+	it->current = it->started ? it->current + (int)gap : (int)(it->current + cgr_zigzagDecode(gap));
+	it->started = true;
+	it->remaining--;
+	*neighbor = it->current;
+	return true;
+}
+
+// Searching Edges
+
+/**
+ * Restituisce true se il grafo contiene un arco dal vertice "source" al vertice "destination".
+ * La ricerca scorre i vicini del vertice sorgente, in tempo proporzionale al suo grado.
+ */
+bool gr_containsEdge(graph* g, int source, int destination) {
+	if (!gr_isValidVertex(g, source)) {
+		INVALID_VERTEX_ERROR("gr_containsEdge", source);
+		return false;
+	}
+	for (long arc = g->offsets[source]; arc < g->offsets[source + 1]; arc++) {
+		if (g->neighbors[arc] == destination) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Restituisce true se il grafo dinamico contiene un arco dal vertice "source" al vertice "destination".
+ */
+bool dgr_containsEdge(dgraph* g, int source, int destination) {
+	if (!dgr_isValidVertex(g, source)) {
+		INVALID_VERTEX_ERROR("dgr_containsEdge", source);
+		return false;
+	}
+	return dgr_findArc(&g->vertices[source], destination) >= 0;
+}
+
+/**
+ * Restituisce true se il grafo compresso contiene l'arco fra i due vertici. Poiché i vicini sono ordinati,
+ * la decodifica si ferma al primo vicino non inferiore alla destinazione.
+ */
+bool cgr_containsEdge(cgraph* g, int source, int destination) {
+	if (source < 0 || source >= g->vertices_number) {
+		INVALID_VERTEX_ERROR("cgr_containsEdge", source);
+		return false;
+	}
+	cgraph_iterator it;
+	cgr_initIterator(g, source, &it);
+	int neighbor;
+	while (cgr_nextNeighbor(&it, &neighbor)) {
+		if (neighbor >= destination) {
+			return neighbor == destination;
+		}
+	}
+	return false;
+}
+
+// Converting Graph
+
+/**
+ * Restituisce il grafo trasposto, in cui ogni arco (u, v) diventa (v, u), costruito in tempo O(V + E) mediante
+ * counting sort sui vertici di destinazione. I vicini di ogni vertice del trasposto sono quindi i suoi predecessori
+ * nel grafo originale, in ordine crescente. Per un grafo non orientato, il trasposto coincide con una copia del grafo.
+ */
+graph* gr_transposeGraph(graph* g) {
+	graph* transposed = malloc(sizeof(graph));
+	if (!transposed) {
+		MEMORY_ERROR;
+	}
+	int vertices_number = g->vertices_number;
+	long arcs_number = g->offsets[vertices_number];
+	transposed->vertices_number = vertices_number;
+	transposed->edges_number = g->edges_number;
+	transposed->directed = g->directed;
+	transposed->mapping = NULL;
+	transposed->mapping_size = 0;
+	transposed->offsets = calloc((size_t)vertices_number + 1, sizeof(long));
+	transposed->neighbors = malloc((size_t)arcs_number * sizeof(int) + 1);
+	transposed->weights = g->weights ? malloc((size_t)arcs_number * sizeof(double) + 1) : NULL;
+	if (!transposed->offsets || !transposed->neighbors || (g->weights && !transposed->weights)) {
+		MEMORY_ERROR;
+	}
+	for (long arc = 0; arc < arcs_number; arc++) {
+		transposed->offsets[g->neighbors[arc] + 1]++;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		transposed->offsets[v + 1] += transposed->offsets[v];
+	}
+	for (int u = 0; u < vertices_number; u++) {
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			long position = transposed->offsets[g->neighbors[arc]]++;
+			transposed->neighbors[position] = u;
+			if (g->weights) {
+				transposed->weights[position] = g->weights[arc];
+			}
+		}
+	}
+	memmove(transposed->offsets + 1, transposed->offsets, (size_t)vertices_number * sizeof(long));
+	transposed->offsets[0] = 0;
+	return transposed;
+}
+
+/**
+ * Restituisce il grafo con i vertici rinominati secondo la permutazione data, in cui permutation[v] è il nuovo indice
+ * del vertice v: l'arco (u, v) diventa (permutation[u], permutation[v]), con lo stesso peso. Se "original_ids" non è
+ * NULL, vi viene scritta la permutazione inversa (original_ids[w] è l'indice originale del nuovo vertice w).
+ * Il grafo viene costruito in tempo O(V + E) scorrendo le destinazioni nel nuovo ordine (tramite i predecessori),
+ * quindi i vicini di ogni vertice risultano in ordine crescente di nuovo indice.
+ * Le permutazioni possono essere calcolate con le funzioni di GraphOrdering.
+ */
+graph* gr_permuteGraph(graph* g, int* permutation, int* original_ids) {
+	graph* permuted = malloc(sizeof(graph));
+	if (!permuted) {
+		MEMORY_ERROR;
+	}
+	int vertices_number = g->vertices_number;
+	long arcs_number = g->offsets[vertices_number];
+	permuted->vertices_number = vertices_number;
+	permuted->edges_number = g->edges_number;
+	permuted->directed = g->directed;
+	permuted->mapping = NULL;
+	permuted->mapping_size = 0;
+	permuted->offsets = calloc((size_t)vertices_number + 1, sizeof(long));
+	permuted->neighbors = malloc((size_t)arcs_number * sizeof(int) + 1);
+	permuted->weights = g->weights ? malloc((size_t)arcs_number * sizeof(double) + 1) : NULL;
+	int* inverse = original_ids ? original_ids : malloc((size_t)vertices_number * sizeof(int) + 1);
+	if (!permuted->offsets || !permuted->neighbors || (g->weights && !permuted->weights) || !inverse) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		inverse[permutation[v]] = v;
+		permuted->offsets[permutation[v] + 1] = g->offsets[v + 1] - g->offsets[v];
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		permuted->offsets[v + 1] += permuted->offsets[v];
+	}
+	// Nel grafo non orientato i predecessori di un vertice coincidono con i suoi vicini
+	graph* in = g->directed ? gr_transposeGraph(g) : g;
+	for (int w = 0; w < vertices_number; w++) {
+		int v = inverse[w];
+		for (long arc = in->offsets[v]; arc < in->offsets[v + 1]; arc++) {
+			long position = permuted->offsets[permutation[in->neighbors[arc]]]++;
+			permuted->neighbors[position] = w;
+			if (g->weights) {
+				permuted->weights[position] = in->weights[arc];
+			}
+		}
+	}
+	memmove(permuted->offsets + 1, permuted->offsets, (size_t)vertices_number * sizeof(long));
+	permuted->offsets[0] = 0;
+	if (in != g) {
+		gr_deleteGraph(in);
+	}
+	if (inverse != original_ids) {
+		free(inverse);
+	}
+	return permuted;
+}
+
+/**
+ * Costruisce (in tempo O(V + E)) un grafo statico in formato CSR con gli stessi vertici e archi del grafo dinamico,
+ * da utilizzare nelle fasi di analisi. Il grafo dinamico non viene modificato, e può essere cancellato o
+ * ulteriormente aggiornato indipendentemente dal grafo restituito.
+ */
+graph* dgr_freezeGraph(dgraph* g) {
+	graph* frozen = malloc(sizeof(graph));
+	if (!frozen) {
+		MEMORY_ERROR;
+	}
+	frozen->vertices_number = g->vertices_number;
+	frozen->edges_number = g->edges_number;
+	frozen->directed = g->directed;
+	frozen->mapping = NULL;
+	frozen->mapping_size = 0;
+	frozen->offsets = malloc(((size_t)g->vertices_number + 1) * sizeof(long));
+	if (!frozen->offsets) {
+		MEMORY_ERROR;
+	}
+	frozen->offsets[0] = 0;
+	for (int v = 0; v < g->vertices_number; v++) {
+		arraylist* neighbors = g->vertices[v].neighbors;
+		frozen->offsets[v + 1] = frozen->offsets[v] + (neighbors ? neighbors->size : 0);
+	}
+	long arcs_number = frozen->offsets[g->vertices_number];
+	frozen->neighbors = malloc((size_t)arcs_number * sizeof(int) + 1);
+	frozen->weights = g->weighted ? malloc((size_t)arcs_number * sizeof(double) + 1) : NULL;
+	if (!frozen->neighbors || (g->weighted && !frozen->weights)) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < g->vertices_number; v++) {
+		dgraph_vertex* vertex = &g->vertices[v];
+		long arc = frozen->offsets[v];
+		for (int i = 0; vertex->neighbors && i < vertex->neighbors->size; i++, arc++) {
+			frozen->neighbors[arc] = dgr_decodeVertex(vertex->neighbors->array[i]);
+			if (frozen->weights) {
+				frozen->weights[arc] = dgr_decodeWeight(vertex->weights->array[i]);
+			}
+		}
+	}
+	return frozen;
+}
+
+/**
+ * Costruisce il grafo compresso (vedi la nota iniziale) con gli stessi vertici e archi del grafo CSR, che non viene
+ * modificato. Le righe vengono passate una alla volta al costruttore incrementale, che le ordina se necessario.
+ */
+cgraph* cgr_compressGraph(graph* g) {
+	cgraph_builder* builder = cgr_initBuilder(g->vertices_number, g->directed);
+	for (int v = 0; v < g->vertices_number; v++) {
+		for (long arc = g->offsets[v]; arc < g->offsets[v + 1]; arc++) {
+			cgr_addArc(builder, v, g->neighbors[arc]);
+		}
+	}
+	cgraph* compressed = cgr_finishBuilder(builder);
+	compressed->edges_number = g->edges_number;
+	return compressed;
+}
+
+// Building Compressed Graph
+
+/**
+ * Inizializza il costruttore incrementale di un grafo compresso con il numero di vertici indicato.
+ * Gli archi vanno aggiunti con "cgr_addArc" e il grafo ottenuto con "cgr_finishBuilder".
+ */
+cgraph_builder* cgr_initBuilder(int vertices_number, bool directed) {
+	cgraph_builder* builder = malloc(sizeof(cgraph_builder));
+	cgraph* compressed = malloc(sizeof(cgraph));
+	if (!builder || !compressed) {
+		MEMORY_ERROR;
+	}
+	compressed->vertices_number = vertices_number;
+	compressed->edges_number = 0;
+	compressed->directed = directed;
+	compressed->max_degree = 0;
+	compressed->anchors = malloc((((size_t)vertices_number >> CGRAPH_ANCHOR_SHIFT) + 1) * sizeof(long));
+	compressed->offsets = malloc(((size_t)vertices_number + 1) * sizeof(uint32_t));
+	compressed->data = malloc(CGRAPH_INITIAL_DATA_CAPACITY);
+	builder->row = malloc(CGRAPH_INITIAL_ROW_CAPACITY * sizeof(int));
+	if (!compressed->anchors || !compressed->offsets || !compressed->data || !builder->row) {
+		MEMORY_ERROR;
+	}
+	builder->graph = compressed;
+	builder->data_size = 0;
+	builder->data_capacity = CGRAPH_INITIAL_DATA_CAPACITY;
+	builder->arcs_number = 0;
+	builder->current_vertex = 0;
+	builder->row_size = 0;
+	builder->row_capacity = CGRAPH_INITIAL_ROW_CAPACITY;
+	return builder;
+}
+
+/**
+ * Registra la posizione della riga del vertice corrente (che apre un nuovo blocco se è il primo del blocco).
+ * Se la posizione relativa al blocco non è rappresentabile a 32 bit, il programma termina con un errore.
+ */
+static void cgr_placeRow(cgraph_builder* b) {
+	cgraph* g = b->graph;
+	int vertex = b->current_vertex;
+	if ((vertex & ((1 << CGRAPH_ANCHOR_SHIFT) - 1)) == 0) {
+		g->anchors[vertex >> CGRAPH_ANCHOR_SHIFT] = b->data_size;
+	}
+	long relative = b->data_size - g->anchors[vertex >> CGRAPH_ANCHOR_SHIFT];
+	if (relative > UINT32_MAX) {
+		printf("Error: Block of rows too large in \"cgr_addArc\" function.\n");
+		exit(1);
+	}
+	g->offsets[vertex] = (uint32_t)relative;
+}
+
+/**
+ * Codifica la riga del vertice corrente (ordinandola se necessario) in coda ai dati, e passa al vertice successivo.
+ */
+static void cgr_flushRow(cgraph_builder* b) {
+	cgraph* g = b->graph;
+	int degree = b->row_size;
+	cgr_placeRow(b);
+	for (int i = 1; i < degree; i++) {
+		if (b->row[i] < b->row[i - 1]) {
+			qsort(b->row, degree, sizeof(int), cgr_compareInts);
+			break;
+		}
+	}
+	long required = b->data_size + (long)(degree + 1) * CGRAPH_MAX_VARINT_SIZE;
+	if (required > b->data_capacity) {
+		while (b->data_capacity < required) {
+			b->data_capacity *= 2;
+		}
+		g->data = realloc(g->data, (size_t)b->data_capacity);
+		if (!g->data) {
+			MEMORY_ERROR;
+		}
+	}
+	b->data_size = cgr_encodeNeighbors(g->data, b->data_size, b->current_vertex, b->row, degree);
+	if (degree > g->max_degree) {
+		g->max_degree = degree;
+	}
+	b->row_size = 0;
+	b->current_vertex++;
+}
+
+/**
+ * Aggiunge un arco al grafo in costruzione. Gli archi devono essere forniti in ordine non decrescente di vertice
+ * sorgente (l'ordine delle destinazioni è invece libero): le righe dei vertici precedenti alla sorgente vengono
+ * codificate e non possono più essere modificate. Per un grafo non orientato, ogni arco va fornito in entrambi
+ * i versi (i cappi una volta sola), come nel grafo CSR: la simmetria viene verificata da "cgr_finishBuilder".
+ * Se un vertice non è valido, o la sorgente precede l'ultima ricevuta, viene stampato un errore, l'arco non viene
+ * aggiunto e viene restituito false; il grafo in costruzione resta valido, ma è compito del chiamante decidere se
+ * scartarlo con "cgr_deleteBuilder".
+ */
+bool cgr_addArc(cgraph_builder* b, int source, int destination) {
+	int vertices_number = b->graph->vertices_number;
+	if (source < 0 || source >= vertices_number) {
+		INVALID_VERTEX_ERROR("cgr_addArc", source);
+		return false;
+	}
+	if (destination < 0 || destination >= vertices_number) {
+		INVALID_VERTEX_ERROR("cgr_addArc", destination);
+		return false;
+	}
+	if (source < b->current_vertex) {
+		printf("Error: Unsorted arc (%d, %d) in \"cgr_addArc\" function.\n", source, destination);
+		return false;
+	}
+	while (b->current_vertex < source) {
+		cgr_flushRow(b);
+	}
+	if (b->row_size == b->row_capacity) {
+		b->row_capacity *= 2;
+		b->row = realloc(b->row, (size_t)b->row_capacity * sizeof(int));
+		if (!b->row) {
+			MEMORY_ERROR;
+		}
+	}
+	b->row[b->row_size++] = destination;
+	b->arcs_number++;
+	if (b->graph->directed || source <= destination) {
+		b->graph->edges_number++;
+	}
+	return true;
+}
+
+/**
+ * Restituisce true se il grafo compresso è simmetrico, ossia se ogni arco (u, v) compare tante volte quante l'arco
+ * (v, u). Le righe vengono scorse in ordine di vertice sorgente, mantenendo un iteratore per ogni vertice: poiché
+ * le righe sono ordinate, l'arco (v, u) deve essere il prossimo vicino non ancora accoppiato di v. Tempo O(V + E).
+ */
+static bool cgr_isSymmetric(cgraph* g) {
+	cgraph_iterator* pending = malloc((size_t)g->vertices_number * sizeof(cgraph_iterator) + 1);
+	if (!pending) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < g->vertices_number; v++) {
+		cgr_initIterator(g, v, &pending[v]);
+	}
+	bool symmetric = true;
+	for (int u = 0; u < g->vertices_number && symmetric; u++) {
+		cgraph_iterator it;
+		cgr_initIterator(g, u, &it);
+		int v;
+		int reverse;
+		while (symmetric && cgr_nextNeighbor(&it, &v)) {
+			symmetric = cgr_nextNeighbor(&pending[v], &reverse) && reverse == u;
+		}
+	}
+	free(pending);
+	return symmetric;
+}
+
+/**
+ * Elimina il costruttore e il grafo compresso parzialmente costruito, senza completarlo.
+ */
+void cgr_deleteBuilder(cgraph_builder* b) {
+	cgr_deleteGraph(b->graph);
+	free(b->row);
+	free(b);
+}
+
+/**
+ * Completa il grafo compresso, codificando le righe ancora mancanti (anche vuote), e lo restituisce.
+ * La memoria dei dati viene ridotta alla dimensione effettiva e il costruttore viene eliminato.
+ * Se il grafo non è orientato ma gli archi ricevuti non sono simmetrici (ad esempio perché ogni arco è stato fornito
+ * in un solo verso), il grafo viene rifiutato: viene stampato un errore, il grafo viene eliminato e viene
+ * restituito NULL. Il grafo non viene simmetrizzato, poiché gli archi inversi violerebbero l'ordine delle righe.
+ */
+cgraph* cgr_finishBuilder(cgraph_builder* b) {
+	cgraph* g = b->graph;
+	while (b->current_vertex < g->vertices_number) {
+		cgr_flushRow(b);
+	}
+	cgr_placeRow(b);
+	g->data = realloc(g->data, (size_t)b->data_size + 1);
+	if (!g->data) {
+		MEMORY_ERROR;
+	}
+	free(b->row);
+	free(b);
+	if (!g->directed && !cgr_isSymmetric(g)) {
+		printf("Error: Asymmetric arcs for undirected graph in \"cgr_finishBuilder\" function.\n");
+		cgr_deleteGraph(g);
+		return NULL;
+	}
+	return g;
+}
+
+/**
+ * Costruisce il grafo compresso leggendo in sequenza un file di testo con un arco per riga, nella forma
+ * "sorgente destinazione", ordinato per vertice sorgente (vedi "cgr_addArc"). Il file non viene mai caricato
+ * interamente in memoria, né viene costruito il grafo CSR corrispondente.
+ * Per un grafo non orientato il file deve contenere ogni arco in entrambi i versi (vedi "cgr_finishBuilder").
+ * Restituisce NULL (dopo aver stampato un errore) se il file non può essere letto, se contiene una riga che non è
+ * una coppia di interi o un arco rifiutato da "cgr_addArc", oppure se il grafo non orientato non è simmetrico.
+ */
+cgraph* cgr_loadEdgeList(const char* path, int vertices_number, bool directed) {
+	FILE* file = fopen(path, "r");
+	if (!file) {
+		FILE_ERROR("cgr_loadEdgeList", path);
+		return NULL;
+	}
+	cgraph_builder* builder = cgr_initBuilder(vertices_number, directed);
+	int source;
+	int destination;
+	int read;
+	bool accepted = true;
+	while (accepted && (read = fscanf(file, "%d %d", &source, &destination)) == 2) {
+		accepted = cgr_addArc(builder, source, destination);
+	}
+	bool success = accepted && (read == EOF) && !ferror(file);
+	fclose(file);
+	if (!success) {
+		if (accepted) {
+			FILE_ERROR("cgr_loadEdgeList", path);	// Altrimenti l'errore è già stato stampato da "cgr_addArc"
+		}
+		cgr_deleteBuilder(builder);
+		return NULL;
+	}
+	return cgr_finishBuilder(builder);
+}
+
+// Storing Graph
+
+/**
+ * Restituisce la prima posizione multipla di GRAPH_FILE_ALIGNMENT non inferiore a quella data.
+ */
+static uint64_t gr_alignFilePosition(uint64_t position) {
+	return (position + GRAPH_FILE_ALIGNMENT - 1) / GRAPH_FILE_ALIGNMENT * GRAPH_FILE_ALIGNMENT;
+}
+
+/**
+ * Scrive un array nel file alla posizione data, riempiendo di zeri lo spazio che lo separa dal contenuto precedente.
+ */
+static bool gr_writeFileSection(FILE* file, uint64_t* written, uint64_t position, const void* data, size_t size) {
+	static const char padding[GRAPH_FILE_ALIGNMENT] = {0};
+	if (fwrite(padding, 1, position - *written, file) != position - *written
+			|| (size > 0 && fwrite(data, 1, size, file) != size)) {
+		return false;
+	}
+	*written = position + size;
+	return true;
+}
+
+/**
+ * Salva il grafo nel formato binario descritto nella nota iniziale, sovrascrivendo il file se già esistente.
+ * Restituisce false (dopo aver stampato un errore) se il file non può essere scritto.
+ */
+bool gr_saveGraph(graph* g, const char* path) {
+	long arcs_number = g->offsets[g->vertices_number];
+	graph_file_header header;
+	memset(&header, 0, sizeof(graph_file_header));
+	memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC));
+	header.version = GRAPH_FILE_VERSION;
+	header.byte_order = GRAPH_FILE_BYTE_ORDER;
+	header.flags = (g->directed ? GRAPH_FILE_DIRECTED : 0) | (g->weights ? GRAPH_FILE_WEIGHTED : 0);
+	header.vertices_number = g->vertices_number;
+	header.edges_number = g->edges_number;
+	header.arcs_number = arcs_number;
+	header.offsets_position = gr_alignFilePosition(sizeof(graph_file_header));
+	header.neighbors_position = gr_alignFilePosition(
+		header.offsets_position + ((uint64_t)g->vertices_number + 1) * sizeof(long));
+	header.weights_position = gr_alignFilePosition(header.neighbors_position + (uint64_t)arcs_number * sizeof(int));
+	header.file_size = g->weights ? header.weights_position + (uint64_t)arcs_number * sizeof(double)
+		: header.weights_position;
+
+	FILE* file = fopen(path, "wb");
+	if (!file) {
+		FILE_ERROR("gr_saveGraph", path);
+		return false;
+	}
+	uint64_t written = 0;
+	bool success = gr_writeFileSection(file, &written, 0, &header, sizeof(graph_file_header))
+		&& gr_writeFileSection(file, &written, header.offsets_position,
+			g->offsets, ((size_t)g->vertices_number + 1) * sizeof(long))
+		&& gr_writeFileSection(file, &written, header.neighbors_position,
+			g->neighbors, (size_t)arcs_number * sizeof(int))
+		&& gr_writeFileSection(file, &written, header.weights_position,
+			g->weights, g->weights ? (size_t)arcs_number * sizeof(double) : 0);
+	success = (fclose(file) == 0) && success;
+	if (!success) {
+		FILE_ERROR("gr_saveGraph", path);
+	}
+	return success;
+}
+
+/**
+ * Restituisce true se una sezione del file di "count" elementi da "size" byte, che inizia alla posizione data,
+ * è allineata a GRAPH_FILE_ALIGNMENT byte, segue l'intestazione ed è interamente contenuta nel file.
+ * I controlli sono scritti in modo da non poter andare in overflow.
+ */
+static bool gr_isValidFileSection(uint64_t position, int64_t count, size_t size, size_t file_size) {
+	return position % GRAPH_FILE_ALIGNMENT == 0
+		&& position >= sizeof(graph_file_header)
+		&& position <= file_size
+		&& count >= 0
+		&& (uint64_t)count <= (file_size - position) / size;
+}
+
+/**
+ * Restituisce true se gli array "offsets" e "neighbors" mappati descrivono un grafo CSR valido: gli offset partono
+ * da zero, non decrescono e terminano con il numero di archi, e ogni vicino è un vertice esistente.
+ */
+static bool gr_isValidFileContent(const graph_file_header* header, const long* offsets, const int* neighbors) {
+	long vertices_number = (long)header->vertices_number;
+	if (offsets[0] != 0 || offsets[vertices_number] != header->arcs_number) {
+		return false;
+	}
+	for (long v = 0; v < vertices_number; v++) {
+		if (offsets[v + 1] < offsets[v]) {
+			return false;
+		}
+	}
+	for (long i = 0; i < header->arcs_number; i++) {
+		if (neighbors[i] < 0 || neighbors[i] >= vertices_number) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Carica un grafo salvato con "gr_saveGraph", mappando il file in memoria in sola lettura: il caricamento non legge
+ * né copia gli array, e le pagine vengono lette dal disco (o dalla cache del sistema operativo) al primo accesso.
+ * Se "prefetch" è vero, viene richiesto al sistema operativo di caricare subito l'intero file (MAP_POPULATE, dove
+ * disponibile, e MADV_WILLNEED), in modo che la prima visita del grafo non paghi il costo dei page fault.
+ * Restituisce NULL (dopo aver stampato un errore) se il file non esiste o non è un grafo in un formato compatibile.
+ * Oltre all'intestazione, vengono verificati gli offset e gli indici dei vicini (in tempo lineare), in modo che un
+ * file danneggiato non possa causare accessi fuori dagli array durante le visite.
+ *
+ * <i>NOTA:</i> Gli array del grafo caricato sono in sola lettura: qualsiasi tentativo di modificarli termina
+ * il programma. Il grafo va eliminato con "gr_deleteGraph", che rimuove la mappatura.
+ */
+graph* gr_loadGraph(const char* path, bool prefetch) {
+	int descriptor = open(path, O_RDONLY);
+	if (descriptor < 0) {
+		FILE_ERROR("gr_loadGraph", path);
+		return NULL;
+	}
+	struct stat file_status;
+	if (fstat(descriptor, &file_status) != 0 || (size_t)file_status.st_size < sizeof(graph_file_header)) {
+		close(descriptor);
+		FILE_ERROR("gr_loadGraph", path);
+		return NULL;
+	}
+	size_t mapping_size = (size_t)file_status.st_size;
+	int mapping_flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+	if (prefetch) {
+		mapping_flags |= MAP_POPULATE;
+	}
+#endif
+	void* mapping = mmap(NULL, mapping_size, PROT_READ, mapping_flags, descriptor, 0);
+	close(descriptor);
+	if (mapping == MAP_FAILED) {
+		FILE_ERROR("gr_loadGraph", path);
+		return NULL;
+	}
+	if (prefetch) {
+		madvise(mapping, mapping_size, MADV_WILLNEED);
+	}
+	graph_file_header* header = (graph_file_header*)mapping;
+	if (memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC)) != 0
+			|| header->version != GRAPH_FILE_VERSION
+			|| header->byte_order != GRAPH_FILE_BYTE_ORDER
+			|| header->file_size != mapping_size
+			|| header->vertices_number < 0 || header->vertices_number > INT_MAX
+			|| header->edges_number < 0 || header->arcs_number < 0 || header->arcs_number > LONG_MAX
+			|| !gr_isValidFileSection(header->offsets_position, header->vertices_number + 1, sizeof(long), mapping_size)
+			|| !gr_isValidFileSection(header->neighbors_position, header->arcs_number, sizeof(int), mapping_size)
+			|| ((header->flags & GRAPH_FILE_WEIGHTED)
+				&& !gr_isValidFileSection(header->weights_position, header->arcs_number, sizeof(double), mapping_size))
+			|| !gr_isValidFileContent(header, (long*)((char*)mapping + header->offsets_position),
+				(int*)((char*)mapping + header->neighbors_position))) {
+		printf("Error: File \"%s\" is not a compatible graph file.\n", path);
+		munmap(mapping, mapping_size);
+		return NULL;
+	}
+	graph* loaded = malloc(sizeof(graph));
+	if (!loaded) {
+		MEMORY_ERROR;
+	}
+	char* base = (char*)mapping;
+	loaded->vertices_number = (int)header->vertices_number;
+	loaded->edges_number = header->edges_number;
+	loaded->directed = (header->flags & GRAPH_FILE_DIRECTED) != 0;
+	loaded->offsets = (long*)(base + header->offsets_position);
+	loaded->neighbors = (int*)(base + header->neighbors_position);
+	loaded->weights = (header->flags & GRAPH_FILE_WEIGHTED) ? (double*)(base + header->weights_position) : NULL;
+	loaded->mapping = mapping;
+	loaded->mapping_size = mapping_size;
+	return loaded;
+}
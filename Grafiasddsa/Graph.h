@@ -0,0 +1,136 @@
+#ifndef GRAPH_H_
+#define GRAPH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ArrayList.h"
+
+typedef struct graph {
+	int vertices_number;
+	long edges_number;
+	bool directed;
+	long* offsets;
+	int* neighbors;
+	double* weights;
+	void* mapping;
+	size_t mapping_size;
+} graph;
+
+typedef struct dgraph_index {
+	int capacity;
+	int size;
+	int* keys;
+	int* positions;
+} dgraph_index;
+
+typedef struct dgraph_vertex {
+	arraylist* neighbors;
+	arraylist* weights;
+	dgraph_index* index;
+} dgraph_vertex;
+
+typedef struct dgraph {
+	int vertices_number;
+	int vertices_capacity;
+	long edges_number;
+	bool directed;
+	bool weighted;
+	bool indexed;
+	dgraph_vertex* vertices;
+} dgraph;
+
+typedef struct cgraph {
+	int vertices_number;
+	long edges_number;
+	bool directed;
+	int max_degree;
+	long* anchors;
+	uint32_t* offsets;
+	unsigned char* data;
+} cgraph;
+
+typedef struct cgraph_iterator {
+	const unsigned char* position;
+	int remaining;
+	int current;
+	bool started;
+} cgraph_iterator;
+
+typedef struct cgraph_builder {
+	cgraph* graph;
+	long data_size;
+	long data_capacity;
+	long arcs_number;
+	int current_vertex;
+	int* row;
+	int row_size;
+	int row_capacity;
+} cgraph_builder;
+
+// Initializing Graph
+graph* gr_initGraphFromEdges(int vertices_number, long edges_number, int* sources, int* destinations,
+		double* weights, bool directed); // OK
+dgraph* dgr_initGraph(int vertices_number, bool directed, bool weighted, bool indexed); // OK
+
+// Size
+int gr_getVerticesNumber(graph* g); // OK
+long gr_getEdgesNumber(graph* g); // OK
+long gr_getArcsNumber(graph* g); // OK
+bool gr_isDirected(graph* g); // OK
+bool gr_isWeighted(graph* g); // OK
+int dgr_getVerticesNumber(dgraph* g); // OK
+long dgr_getEdgesNumber(dgraph* g); // OK
+int cgr_getVerticesNumber(cgraph* g); // OK
+long cgr_getEdgesNumber(cgraph* g); // OK
+size_t gr_getMemorySize(graph* g); // OK
+size_t cgr_getMemorySize(cgraph* g); // OK
+
+// Cancelling Graph
+void gr_deleteGraph(graph* g); // OK
+void dgr_deleteGraph(dgraph* g); // OK
+void cgr_deleteGraph(cgraph* g); // OK
+
+// Updating Graph
+int dgr_addVertex(dgraph* g); // OK
+void dgr_addEdge(dgraph* g, int source, int destination, double weight); // OK
+bool dgr_deleteEdge(dgraph* g, int source, int destination); // OK
+
+// Getting Neighbors
+int gr_getVertexDegree(graph* g, int vertex); // OK
+int* gr_getNeighbors(graph* g, int vertex); // OK
+double* gr_getNeighborsWeights(graph* g, int vertex); // OK
+double gr_getArcWeight(graph* g, long arc); // OK
+int dgr_getVertexDegree(dgraph* g, int vertex); // OK
+int dgr_getNeighbor(dgraph* g, int vertex, int i); // OK
+double dgr_getNeighborWeight(dgraph* g, int vertex, int i); // OK
+int cgr_getVertexDegree(cgraph* g, int vertex); // OK
+int cgr_getNeighbors(cgraph* g, int vertex, int* neighbors); // OK
+long cgr_getRowPosition(cgraph* g, int vertex); // OK
+void cgr_initIterator(cgraph* g, int vertex, cgraph_iterator* it); // OK
+bool cgr_nextNeighbor(cgraph_iterator* it, int* neighbor); // OK
+
+// Searching Edges
+bool gr_containsEdge(graph* g, int source, int destination); // OK
+bool dgr_containsEdge(dgraph* g, int source, int destination); // OK
+bool cgr_containsEdge(cgraph* g, int source, int destination); // OK
+
+// Converting Graph
+graph* gr_transposeGraph(graph* g); // OK
+graph* gr_permuteGraph(graph* g, int* permutation, int* original_ids); // OK
+graph* dgr_freezeGraph(dgraph* g); // OK
+cgraph* cgr_compressGraph(graph* g); // OK
+
+// Building Compressed Graph
+cgraph_builder* cgr_initBuilder(int vertices_number, bool directed); // OK
+bool cgr_addArc(cgraph_builder* b, int source, int destination); // OK
+cgraph* cgr_finishBuilder(cgraph_builder* b); // OK
+void cgr_deleteBuilder(cgraph_builder* b); // OK
+cgraph* cgr_loadEdgeList(const char* path, int vertices_number, bool directed); // OK
+
+// Storing Graph
+bool gr_saveGraph(graph* g, const char* path); // OK
+graph* gr_loadGraph(const char* path, bool prefetch); // OK
+
+#endif
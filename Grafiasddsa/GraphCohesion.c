@@ -0,0 +1,610 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "GraphCohesion.h"
+#include "ThreadPool.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#define VERTICES_CHUNK 1024
+#define TRIANGLES_CHUNK 64
+#define FRONTIER_CHUNK 64
+#define GALLOPING_RATIO 32
+#define PUSH_BUFFER_SIZE 256
+
+/**
+ * Libreria che implementa il conteggio dei triangoli (con il coefficiente di clustering locale) e la decomposizione
+ * in k-core del grafo CSR non orientato.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Tutte le funzioni considerano il grafo come semplice: i cappi vengono ignorati e gli archi multipli contano una
+ * volta sola. Se le righe del grafo sono già ordinate e senza ripetizioni (ad esempio quando gli archi sono forniti
+ * in ordine) vengono usate direttamente; altrimenti ne viene costruita una copia ordinata. I risultati per vertice
+ * sono scritti in array forniti dal chiamante, di lunghezza pari al numero di vertici. Su un grafo orientato viene
+ * stampato un errore e restituito -1.
+ *
+ * Triangoli: i vertici vengono ordinati per grado (a parità di grado, per indice), e ogni arco viene orientato dal
+ * vertice che precede a quello che segue. Ogni triangolo {u, v, w} con u < v < w in quest'ordine viene trovato una
+ * sola volta, come elemento comune delle liste uscenti di u e di v. Le liste uscenti hanno al più O(sqrt(E))
+ * elementi, e il costo totale è O(E sqrt(E)) anche sui grafi con vertici di grado molto elevato. Le intersezioni
+ * scorrono le due liste in parallelo ("merge"), oppure, se una è più lunga dell'altra di un fattore GALLOPING_RATIO,
+ * cercano ogni elemento della lista corta nella lunga con una ricerca esponenziale ("galloping"). I vertici vengono
+ * suddivisi fra i thread in blocchi di TRIANGLES_CHUNK vertici, assegnati dinamicamente; i contatori per vertice
+ * vengono incrementati con operazioni atomiche.
+ *
+ * K-core: il core number di un vertice è il massimo k per cui il vertice appartiene a un sottografo in cui tutti i
+ * vertici hanno grado almeno k. La versione sequenziale è l'algoritmo di Batagelj e Zaversnik: i vertici sono
+ * ordinati per grado in un array suddiviso in "bucket", e vengono rimossi in ordine di grado, spostando ogni vicino
+ * nel bucket precedente quando il suo grado diminuisce; il costo è O(V + E).
+ * La versione parallela rimuove i vertici per livelli (come l'algoritmo PKC): al livello k vengono raccolti i vertici
+ * di grado k, e la loro rimozione decrementa atomicamente il grado dei vicini, aggiungendo alla frontiera successiva
+ * quelli che scendono a k; il livello termina quando la frontiera è vuota. I livelli senza vertici vengono saltati.
+ * Ogni livello richiede una scansione dei vertici, per un costo totale O(E + V * numero di livelli non vuoti).
+ */
+
+// Static Utility Functions
+
+typedef struct gh_state {
+	graph* g;
+	threadpool* pool;
+	int* neighbors;
+	int* degrees;
+	bool simple;
+	long* out_offsets;
+	int* out_neighbors;
+	long* triangles;
+	long triangles_number;
+	int* cores;
+	int level;
+	int next_level;
+	int* frontier;
+	int frontier_size;
+	int* next_frontier;
+	int next_size;
+} gh_state;
+
+/**
+ * Restituisce true se il grafo è orientato, stampando un errore.
+ */
+static bool gh_checkDirected(graph* g, const char* instr) {
+	if (g->directed) {
+		printf("Error: Cannot execute \"%s\" function on directed graph.\n", instr);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Confronta due interi, per l'ordinamento delle righe.
+ */
+static int gh_compareInts(const void* first, const void* second) {
+	int a = *(const int*)first;
+	int b = *(const int*)second;
+	return (a > b) - (a < b);
+}
+
+/**
+ * Esegue una fase su tutti i thread del gruppo, sugli elementi da 0 a "limit".
+ */
+static void gh_runStep(gh_state* s, int limit, void* (*step)(void*)) {
+	tp_runStep(s->pool, step, s, 0, limit);
+}
+
+/**
+ * Verifica che le righe siano ordinate, senza ripetizioni né cappi, e ne memorizza la lunghezza come grado.
+ */
+static void* gh_checkStep(void* arg) {
+	gh_state* s = (gh_state*)arg;
+	long* offsets = s->g->offsets;
+	int* neighbors = s->g->neighbors;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		bool simple = true;
+		for (int v = begin; v < end; v++) {
+			s->degrees[v] = (int)(offsets[v + 1] - offsets[v]);
+			for (long arc = offsets[v]; arc < offsets[v + 1]; arc++) {
+				if (neighbors[arc] == v || (arc > offsets[v] && neighbors[arc] <= neighbors[arc - 1])) {
+					simple = false;
+				}
+			}
+		}
+		if (!simple) {
+			__atomic_store_n(&s->simple, false, __ATOMIC_RELAXED);
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Copia ogni riga nella stessa posizione dell'array "neighbors" dello stato, la ordina, ed elimina ripetizioni e cappi
+ * (compattando la riga all'inizio del suo spazio).
+ */
+static void* gh_simplifyStep(void* arg) {
+	gh_state* s = (gh_state*)arg;
+	long* offsets = s->g->offsets;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int v = begin; v < end; v++) {
+			int* row = s->neighbors + offsets[v];
+			int length = (int)(offsets[v + 1] - offsets[v]);
+			memcpy(row, s->g->neighbors + offsets[v], (size_t)length * sizeof(int));
+			qsort(row, length, sizeof(int), gh_compareInts);
+			int degree = 0;
+			for (int i = 0; i < length; i++) {
+				if (row[i] != v && (degree == 0 || row[i] != row[degree - 1])) {
+					row[degree++] = row[i];
+				}
+			}
+			s->degrees[v] = degree;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Inizializza lo stato comune: numero di thread (se non positivo, uno per processore), righe semplici e gradi.
+ */
+static void gh_initState(gh_state* s, graph* g, int threads_number) {
+	memset(s, 0, sizeof(gh_state));
+	s->g = g;
+	s->pool = tp_initThreadPool(threads_number);
+	s->degrees = malloc((size_t)g->vertices_number * sizeof(int) + 1);
+	if (!s->degrees) {
+		MEMORY_ERROR;
+	}
+	s->simple = true;
+	gh_runStep(s, g->vertices_number, gh_checkStep);
+	if (s->simple) {
+		s->neighbors = g->neighbors;
+	} else {
+		s->neighbors = malloc((size_t)g->offsets[g->vertices_number] * sizeof(int) + 1);
+		if (!s->neighbors) {
+			MEMORY_ERROR;
+		}
+		gh_runStep(s, g->vertices_number, gh_simplifyStep);
+	}
+}
+
+/**
+ * Libera la memoria dello stato comune.
+ */
+static void gh_deleteState(gh_state* s) {
+	if (!s->simple) {
+		free(s->neighbors);
+	}
+	free(s->degrees);
+	tp_deleteThreadPool(s->pool);
+}
+
+/**
+ * Restituisce true se il vertice [u] precede il vertice [v] nell'ordine per grado.
+ */
+static inline bool gh_precedes(const int* degrees, int u, int v) {
+	return degrees[u] < degrees[v] || (degrees[u] == degrees[v] && u < v);
+}
+
+/**
+ * Conta i vicini uscenti di ogni vertice nell'orientamento per grado, memorizzandoli in out_offsets[v + 1].
+ */
+static void* gh_orientCountStep(void* arg) {
+	gh_state* s = (gh_state*)arg;
+	long* offsets = s->g->offsets;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int u = begin; u < end; u++) {
+			long count = 0;
+			for (long arc = offsets[u]; arc < offsets[u] + s->degrees[u]; arc++) {
+				count += gh_precedes(s->degrees, u, s->neighbors[arc]);
+			}
+			s->out_offsets[u + 1] = count;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Scrive i vicini uscenti di ogni vertice, che restano ordinati per indice come nelle righe semplici.
+ */
+static void* gh_orientFillStep(void* arg) {
+	gh_state* s = (gh_state*)arg;
+	long* offsets = s->g->offsets;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int u = begin; u < end; u++) {
+			long position = s->out_offsets[u];
+			for (long arc = offsets[u]; arc < offsets[u] + s->degrees[u]; arc++) {
+				if (gh_precedes(s->degrees, u, s->neighbors[arc])) {
+					s->out_neighbors[position++] = s->neighbors[arc];
+				}
+			}
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Restituisce la prima posizione dell'array ordinato, a partire da "low", il cui elemento non è minore di "value",
+ * con una ricerca esponenziale seguita da una ricerca binaria.
+ */
+static long gh_gallop(const int* array, long low, long size, int value) {
+	long step = 1;
+	while (low + step < size && array[low + step] < value) {
+		low += step;
+		step *= 2;
+	}
+	long high = low + step < size ? low + step : size;
+	while (low < high) {
+		long middle = low + (high - low) / 2;
+		if (array[middle] < value) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+/**
+ * Conta gli elementi comuni di due array ordinati, incrementando (se "triangles" non è NULL) il contatore di ciascuno.
+ */
+static long gh_intersect(const int* first, long first_size, const int* second, long second_size, long* triangles) {
+	if (first_size > second_size) {
+		const int* array = first;
+		first = second;
+		second = array;
+		long size = first_size;
+		first_size = second_size;
+		second_size = size;
+	}
+	long common = 0;
+	long i = 0;
+	long j = 0;
+	if (first_size * GALLOPING_RATIO < second_size) {
+		for (; i < first_size && j < second_size; i++) {
+			j = gh_gallop(second, j, second_size, first[i]);
+			if (j < second_size && second[j] == first[i]) {
+				common++;
+				if (triangles) {
+					__atomic_fetch_add(&triangles[first[i]], 1, __ATOMIC_RELAXED);
+				}
+				j++;
+			}
+		}
+		return common;
+	}
+	while (i < first_size && j < second_size) {
+		if (first[i] < second[j]) {
+			i++;
+		} else if (first[i] > second[j]) {
+			j++;
+		} else {
+			common++;
+			if (triangles) {
+				__atomic_fetch_add(&triangles[first[i]], 1, __ATOMIC_RELAXED);
+			}
+			i++;
+			j++;
+		}
+	}
+	return common;
+}
+
+/**
+ * Conta i triangoli trovati da ogni arco orientato (u, v), come intersezione delle liste uscenti di u e di v.
+ */
+static void* gh_trianglesStep(void* arg) {
+	gh_state* s = (gh_state*)arg;
+	long* out_offsets = s->out_offsets;
+	int* out_neighbors = s->out_neighbors;
+	long found = 0;
+	int begin, end;
+	while (tp_nextChunk(s->pool, TRIANGLES_CHUNK, &begin, &end)) {
+		for (int u = begin; u < end; u++) {
+			long u_count = 0;
+			for (long arc = out_offsets[u]; arc < out_offsets[u + 1]; arc++) {
+				int v = out_neighbors[arc];
+				long common = gh_intersect(out_neighbors + out_offsets[u], out_offsets[u + 1] - out_offsets[u],
+						out_neighbors + out_offsets[v], out_offsets[v + 1] - out_offsets[v], s->triangles);
+				if (common > 0 && s->triangles) {
+					__atomic_fetch_add(&s->triangles[v], common, __ATOMIC_RELAXED);
+				}
+				u_count += common;
+			}
+			if (u_count > 0 && s->triangles) {
+				__atomic_fetch_add(&s->triangles[u], u_count, __ATOMIC_RELAXED);
+			}
+			found += u_count;
+		}
+	}
+	__atomic_fetch_add(&s->triangles_number, found, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+/**
+ * Conta i triangoli del grafo semplice dello stato (vedi la nota iniziale), con gli eventuali contatori per vertice.
+ */
+static long gh_runTriangles(gh_state* s, long* triangles) {
+	int vertices_number = s->g->vertices_number;
+	s->out_offsets = malloc(((size_t)vertices_number + 1) * sizeof(long));
+	if (!s->out_offsets) {
+		MEMORY_ERROR;
+	}
+	s->out_offsets[0] = 0;
+	gh_runStep(s, vertices_number, gh_orientCountStep);
+	for (int v = 0; v < vertices_number; v++) {
+		s->out_offsets[v + 1] += s->out_offsets[v];
+	}
+	s->out_neighbors = malloc((size_t)s->out_offsets[vertices_number] * sizeof(int) + 1);
+	if (!s->out_neighbors) {
+		MEMORY_ERROR;
+	}
+	gh_runStep(s, vertices_number, gh_orientFillStep);
+	if (triangles) {
+		memset(triangles, 0, (size_t)vertices_number * sizeof(long));
+	}
+	s->triangles = triangles;
+	s->triangles_number = 0;
+	gh_runStep(s, vertices_number, gh_trianglesStep);
+	free(s->out_offsets);
+	free(s->out_neighbors);
+	return s->triangles_number;
+}
+
+/**
+ * Abbassa atomicamente il valore puntato al minimo fra esso e il valore dato.
+ */
+static void gh_atomicMin(int* target, int value) {
+	int current = __atomic_load_n(target, __ATOMIC_RELAXED);
+	while (value < current
+			&& !__atomic_compare_exchange_n(target, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+	}
+}
+
+/**
+ * Aggiunge un blocco di vertici alla frontiera data, riservandone lo spazio con un'unica operazione atomica.
+ */
+static void gh_flushBuffer(int* frontier, int* size, int* buffer, int buffered) {
+	int position = __atomic_fetch_add(size, buffered, __ATOMIC_RELAXED);
+	memcpy(frontier + position, buffer, (size_t)buffered * sizeof(int));
+}
+
+/**
+ * Raccoglie nella frontiera i vertici di grado pari al livello corrente, e calcola il minimo grado maggiore
+ * del livello (da cui riprendere se la frontiera è vuota).
+ */
+static void* gh_scanStep(void* arg) {
+	gh_state* s = (gh_state*)arg;
+	int buffer[PUSH_BUFFER_SIZE];
+	int buffered = 0;
+	int next_level = INT_MAX;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int v = begin; v < end; v++) {
+			int core = s->cores[v];
+			if (core == s->level) {
+				if (buffered == PUSH_BUFFER_SIZE) {
+					gh_flushBuffer(s->frontier, &s->frontier_size, buffer, buffered);
+					buffered = 0;
+				}
+				buffer[buffered++] = v;
+			} else if (core > s->level && core < next_level) {
+				next_level = core;
+			}
+		}
+	}
+	if (buffered > 0) {
+		gh_flushBuffer(s->frontier, &s->frontier_size, buffer, buffered);
+	}
+	gh_atomicMin(&s->next_level, next_level);
+	return NULL;
+}
+
+/**
+ * Rimuove i vertici della frontiera, decrementando il grado dei vicini non ancora rimossi. Un vicino che scende al
+ * livello corrente viene aggiunto alla frontiera successiva; un decremento che lo porterebbe sotto il livello
+ * (per una rimozione concorrente) viene annullato.
+ */
+static void* gh_peelStep(void* arg) {
+	gh_state* s = (gh_state*)arg;
+	long* offsets = s->g->offsets;
+	int level = s->level;
+	int buffer[PUSH_BUFFER_SIZE];
+	int buffered = 0;
+	int begin, end;
+	while (tp_nextChunk(s->pool, FRONTIER_CHUNK, &begin, &end)) {
+		for (int i = begin; i < end; i++) {
+			int v = s->frontier[i];
+			for (long arc = offsets[v]; arc < offsets[v] + s->degrees[v]; arc++) {
+				int u = s->neighbors[arc];
+				if (__atomic_load_n(&s->cores[u], __ATOMIC_RELAXED) <= level) {
+					continue;
+				}
+				int previous = __atomic_fetch_sub(&s->cores[u], 1, __ATOMIC_RELAXED);
+				if (previous == level + 1) {
+					if (buffered == PUSH_BUFFER_SIZE) {
+						gh_flushBuffer(s->next_frontier, &s->next_size, buffer, buffered);
+						buffered = 0;
+					}
+					buffer[buffered++] = u;
+				} else if (previous <= level) {
+					__atomic_fetch_add(&s->cores[u], 1, __ATOMIC_RELAXED);
+				}
+			}
+		}
+	}
+	if (buffered > 0) {
+		gh_flushBuffer(s->next_frontier, &s->next_size, buffer, buffered);
+	}
+	return NULL;
+}
+
+// Triangles
+
+/**
+ * Conta i triangoli del grafo, utilizzando il numero di thread dato (se non positivo, uno per processore).
+ * Se l'array "triangles" non è NULL, vi viene scritto il numero di triangoli a cui appartiene ogni vertice.
+ * Restituisce il numero totale di triangoli, oppure -1 se il grafo è orientato.
+ */
+long gh_countTriangles(graph* g, int threads_number, long* triangles) {
+	if (gh_checkDirected(g, "gh_countTriangles")) {
+		return -1;
+	}
+	gh_state s;
+	gh_initState(&s, g, threads_number);
+	long triangles_number = gh_runTriangles(&s, triangles);
+	gh_deleteState(&s);
+	return triangles_number;
+}
+
+/**
+ * Scrive nell'array "coefficients" il coefficiente di clustering locale di ogni vertice, cioè la frazione delle
+ * coppie di suoi vicini che sono collegate da un arco (0 se il vertice ha meno di due vicini), e restituisce la media
+ * dei coefficienti su tutti i vertici, oppure -1 se il grafo è orientato.
+ */
+double gh_clusteringCoefficients(graph* g, int threads_number, double* coefficients) {
+	if (gh_checkDirected(g, "gh_clusteringCoefficients")) {
+		return -1;
+	}
+	int vertices_number = g->vertices_number;
+	long* triangles = malloc((size_t)vertices_number * sizeof(long) + 1);
+	if (!triangles) {
+		MEMORY_ERROR;
+	}
+	gh_state s;
+	gh_initState(&s, g, threads_number);
+	gh_runTriangles(&s, triangles);
+	double sum = 0;
+	for (int v = 0; v < vertices_number; v++) {
+		double degree = s.degrees[v];
+		coefficients[v] = degree < 2 ? 0 : 2.0 * triangles[v] / (degree * (degree - 1));
+		sum += coefficients[v];
+	}
+	gh_deleteState(&s);
+	free(triangles);
+	return vertices_number > 0 ? sum / vertices_number : 0;
+}
+
+// Cores
+
+/**
+ * Scrive nell'array "cores" il core number di ogni vertice, con l'algoritmo di Batagelj e Zaversnik (vedi la nota
+ * iniziale), e restituisce il massimo (la degenerazione del grafo), oppure -1 se il grafo è orientato.
+ */
+int gh_coreDecomposition(graph* g, int* cores) {
+	if (gh_checkDirected(g, "gh_coreDecomposition")) {
+		return -1;
+	}
+	int vertices_number = g->vertices_number;
+	gh_state s;
+	gh_initState(&s, g, 1);
+	int max_degree = 0;
+	for (int v = 0; v < vertices_number; v++) {
+		cores[v] = s.degrees[v];
+		if (cores[v] > max_degree) {
+			max_degree = cores[v];
+		}
+	}
+	// bins[d] è l'inizio del bucket dei vertici di grado d nell'array "sorted"; positions[v] è la posizione di [v]
+	int* bins = calloc((size_t)max_degree + 2, sizeof(int));
+	int* sorted = malloc((size_t)vertices_number * sizeof(int) + 1);
+	int* positions = malloc((size_t)vertices_number * sizeof(int) + 1);
+	if (!bins || !sorted || !positions) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		bins[cores[v] + 1]++;
+	}
+	for (int d = 0; d < max_degree; d++) {
+		bins[d + 1] += bins[d];
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		positions[v] = bins[cores[v]]++;
+		sorted[positions[v]] = v;
+	}
+	// Al termine bins[d] indica la fine del bucket [d]: riporto ogni bucket al suo inizio
+	for (int d = max_degree; d > 0; d--) {
+		bins[d] = bins[d - 1];
+	}
+	bins[0] = 0;
+	int max_core = 0;
+	for (int i = 0; i < vertices_number; i++) {
+		int v = sorted[i];
+		if (cores[v] > max_core) {
+			max_core = cores[v];
+		}
+		for (long arc = g->offsets[v]; arc < g->offsets[v] + s.degrees[v]; arc++) {
+			int u = s.neighbors[arc];
+			if (cores[u] > cores[v]) {
+				// Scambio [u] con il primo vertice del suo bucket, che viene poi ristretto di una posizione
+				int first_position = bins[cores[u]];
+				int first = sorted[first_position];
+				if (first != u) {
+					sorted[positions[u]] = first;
+					positions[first] = positions[u];
+					sorted[first_position] = u;
+					positions[u] = first_position;
+				}
+				bins[cores[u]]++;
+				cores[u]--;
+			}
+		}
+	}
+	free(bins);
+	free(sorted);
+	free(positions);
+	gh_deleteState(&s);
+	return max_core;
+}
+
+/**
+ * Scrive nell'array "cores" il core number di ogni vertice, rimuovendo i vertici per livelli in parallelo (vedi la
+ * nota iniziale) con il numero di thread dato (se non positivo, uno per processore). Restituisce il massimo core
+ * number, oppure -1 se il grafo è orientato.
+ */
+int gh_parallelCoreDecomposition(graph* g, int threads_number, int* cores) {
+	if (gh_checkDirected(g, "gh_parallelCoreDecomposition")) {
+		return -1;
+	}
+	int vertices_number = g->vertices_number;
+	gh_state s;
+	gh_initState(&s, g, threads_number);
+	memcpy(cores, s.degrees, (size_t)vertices_number * sizeof(int));
+	s.cores = cores;
+	s.frontier = malloc((size_t)vertices_number * sizeof(int) + 1);
+	s.next_frontier = malloc((size_t)vertices_number * sizeof(int) + 1);
+	if (!s.frontier || !s.next_frontier) {
+		MEMORY_ERROR;
+	}
+	int removed = 0;
+	int max_core = 0;
+	s.level = 0;
+	while (removed < vertices_number) {
+		s.frontier_size = 0;
+		s.next_level = INT_MAX;
+		gh_runStep(&s, vertices_number, gh_scanStep);
+		if (s.frontier_size == 0) {
+			s.level = s.next_level;
+			continue;
+		}
+		max_core = s.level;
+		while (s.frontier_size > 0) {
+			removed += s.frontier_size;
+			s.next_size = 0;
+			gh_runStep(&s, s.frontier_size, gh_peelStep);
+			int* frontier = s.frontier;
+			s.frontier = s.next_frontier;
+			s.next_frontier = frontier;
+			s.frontier_size = s.next_size;
+		}
+		s.level++;
+	}
+	free(s.frontier);
+	free(s.next_frontier);
+	gh_deleteState(&s);
+	return max_core;
+}
@@ -0,0 +1,14 @@
+#ifndef GRAPHCOHESION_H_
+#define GRAPHCOHESION_H_
+
+#include "Graph.h"
+
+// Triangles
+long gh_countTriangles(graph* g, int threads_number, long* triangles); // OK
+double gh_clusteringCoefficients(graph* g, int threads_number, double* coefficients); // OK
+
+// Cores
+int gh_coreDecomposition(graph* g, int* cores); // OK
+int gh_parallelCoreDecomposition(graph* g, int threads_number, int* cores); // OK
+
+#endif
@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "GraphComponents.h"
+#include "ThreadPool.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#define NEIGHBOR_ROUNDS 2
+#define SAMPLES_NUMBER 1024
+#define VERTICES_CHUNK 1024
+#define NO_COMPONENT (-1)
+
+/**
+ * Libreria che implementa il calcolo delle componenti connesse del grafo CSR, basato sulla struttura union-find.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Le componenti vengono restituite come etichette: l'array "labels" (fornito dal chiamante, di lunghezza pari al
+ * numero di vertici) associa ad ogni vertice l'indice della sua componente, da 0 al numero di componenti meno uno,
+ * numerate nell'ordine del loro vertice più piccolo. Se il grafo è orientato, le componenti calcolate sono quelle
+ * debolmente connesse (l'orientamento degli archi viene ignorato).
+ *
+ * La versione parallela segue l'algoritmo Afforest (Sutton et al.), sulle operazioni concorrenti dell'union-find.
+ * - Campionamento: per NEIGHBOR_ROUNDS turni, ogni vertice viene unito al suo i-esimo vicino. Questo basta, di solito,
+ *   a scoprire quasi per intero la componente più grande.
+ * - Si stima la componente più grande (la più frequente fra SAMPLES_NUMBER vertici scelti a caso).
+ * - Completamento: i vertici che non appartengono a quella componente vengono uniti ai vicini rimanenti. I vertici
+ *   della componente più grande vengono saltati: i loro archi verso l'esterno vengono comunque visti dall'altro estremo,
+ *   e la maggior parte degli archi del grafo non viene mai letta. Il salto è possibile solo se il grafo non è orientato.
+ * Ogni fase viene suddivisa fra i thread in blocchi di VERTICES_CHUNK vertici, assegnati dinamicamente.
+ *
+ * Per mantenere le componenti mentre vengono aggiunti nuovi archi (o vertici) si può usare l'union-find restituito da
+ * "gc_initComponents": ogni nuovo arco corrisponde ad una chiamata di "uf_unionSets" (o "uf_concurrentUnionSets"),
+ * e ogni nuovo vertice ad una chiamata di "uf_addElement".
+ *
+ * Le componenti fortemente connesse vengono calcolate con la variante di Pearce dell'algoritmo di Tarjan, in forma
+ * iterativa (la profondità della visita non è limitata dallo stack del programma) e con memoria ausiliaria limitata:
+ * l'array "labels" viene usato durante la visita come indice di ogni vertice, e un solo array di vertici contiene
+ * sia la pila della visita (dal fondo) sia la pila dei vertici in attesa di componente (dalla cima), dato che i due
+ * insiemi sono disgiunti. In totale servono circa 12 byte e un bit per vertice, oltre a "labels".
+ */
+
+// Static Utility Functions
+
+typedef struct gc_afforest_state {
+	graph* g;
+	unionfind* uf;
+	int round;
+	int skipped_component;
+	threadpool* pool;
+} gc_afforest_state;
+
+/**
+ * Confronta due interi, per l'ordinamento dei campioni.
+ */
+static int gc_compareInts(const void* first, const void* second) {
+	int a = *(const int*)first;
+	int b = *(const int*)second;
+	return (a > b) - (a < b);
+}
+
+/**
+ * Turno di campionamento: ogni vertice viene unito al suo vicino di indice "round", se esiste.
+ */
+static void* gc_sampleStep(void* arg) {
+	gc_afforest_state* s = (gc_afforest_state*)arg;
+	long* offsets = s->g->offsets;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int v = begin; v < end; v++) {
+			long arc = offsets[v] + s->round;
+			if (arc < offsets[v + 1]) {
+				uf_concurrentUnionSets(s->uf, v, s->g->neighbors[arc]);
+			}
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Completamento: ogni vertice esterno alla componente saltata viene unito ai vicini non ancora campionati.
+ */
+static void* gc_finishStep(void* arg) {
+	gc_afforest_state* s = (gc_afforest_state*)arg;
+	long* offsets = s->g->offsets;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int v = begin; v < end; v++) {
+			if (s->skipped_component != NO_COMPONENT && uf_concurrentFindSet(s->uf, v) == s->skipped_component) {
+				continue;
+			}
+			for (long arc = offsets[v] + NEIGHBOR_ROUNDS; arc < offsets[v + 1]; arc++) {
+				uf_concurrentUnionSets(s->uf, v, s->g->neighbors[arc]);
+			}
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Compressione: ogni vertice viene appeso direttamente alla radice del suo albero, in modo che le ricerche
+ * successive terminino in un passo.
+ */
+static void* gc_compressStep(void* arg) {
+	gc_afforest_state* s = (gc_afforest_state*)arg;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int v = begin; v < end; v++) {
+			__atomic_store_n(&s->uf->parents[v], uf_concurrentFindSet(s->uf, v), __ATOMIC_RELAXED);
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Stima la componente più grande come la più frequente fra SAMPLES_NUMBER vertici pseudo-casuali.
+ */
+static int gc_sampleLargestComponent(unionfind* uf) {
+	int samples[SAMPLES_NUMBER];
+	unsigned long seed = 1;
+	for (int i = 0; i < SAMPLES_NUMBER; i++) {
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		samples[i] = uf_concurrentFindSet(uf, (int)((seed >> 33) % (unsigned long)uf->elements_number));
+	}
+	qsort(samples, SAMPLES_NUMBER, sizeof(int), gc_compareInts);
+	int best = samples[0];
+	int best_count = 0;
+	for (int i = 0, count = 0; i < SAMPLES_NUMBER; i++) {
+		count = (i > 0 && samples[i] == samples[i - 1]) ? count + 1 : 1;
+		if (count > best_count) {
+			best = samples[i];
+			best_count = count;
+		}
+	}
+	return best;
+}
+
+// Connected Components
+
+/**
+ * Calcola le componenti connesse del grafo, unendo gli estremi di ogni arco in un union-find.
+ * Restituisce il numero di componenti.
+ */
+int gc_connectedComponents(graph* g, int* labels) {
+	unionfind* uf = gc_initComponents(g);
+	int components_number = gc_getComponentLabels(uf, labels);
+	uf_deleteUnionFind(uf);
+	return components_number;
+}
+
+/**
+ * Calcola le componenti connesse del grafo con l'algoritmo Afforest, utilizzando il numero di thread dato
+ * (se non positivo, uno per processore). Restituisce il numero di componenti.
+ */
+int gc_parallelConnectedComponents(graph* g, int threads_number, int* labels) {
+	gc_afforest_state s;
+	s.pool = tp_initThreadPool(threads_number);
+	s.g = g;
+	s.uf = uf_initUnionFind(g->vertices_number);
+	for (s.round = 0; s.round < NEIGHBOR_ROUNDS; s.round++) {
+		tp_runStep(s.pool, gc_sampleStep, &s, 0, g->vertices_number);
+		tp_runStep(s.pool, gc_compressStep, &s, 0, g->vertices_number);
+	}
+	s.skipped_component = (!g->directed && g->vertices_number > 0) ? gc_sampleLargestComponent(s.uf) : NO_COMPONENT;
+	tp_runStep(s.pool, gc_finishStep, &s, 0, g->vertices_number);
+	int components_number = gc_getComponentLabels(s.uf, labels);
+	uf_deleteUnionFind(s.uf);
+	tp_deleteThreadPool(s.pool);
+	return components_number;
+}
+
+// Incremental Components
+
+/**
+ * Inizializza un union-find i cui insiemi sono le componenti connesse del grafo. Aggiornandolo con i nuovi archi
+ * (tramite "uf_unionSets") le componenti vengono mantenute senza ricalcolarle da capo.
+ */
+unionfind* gc_initComponents(graph* g) {
+	unionfind* uf = uf_initUnionFind(g->vertices_number);
+	for (int u = 0; u < g->vertices_number; u++) {
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			if (!g->directed && g->neighbors[arc] > u) {
+				continue;
+			}
+			uf_unionSets(uf, u, g->neighbors[arc]);
+		}
+	}
+	return uf;
+}
+
+/**
+ * Scrive nell'array "labels" l'indice della componente (insieme) di ogni elemento dell'union-find, da 0 al numero di
+ * componenti meno uno, e restituisce il numero di componenti.
+ */
+int gc_getComponentLabels(unionfind* uf, int* labels) {
+	int elements_number = uf->elements_number;
+	int* root_labels = malloc(((size_t)elements_number + 1) * sizeof(int));
+	if (!root_labels) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < elements_number; v++) {
+		root_labels[v] = NO_COMPONENT;
+	}
+	int components_number = 0;
+	for (int v = 0; v < elements_number; v++) {
+		int root = uf_findSet(uf, v);
+		if (root_labels[root] == NO_COMPONENT) {
+			root_labels[root] = components_number++;
+		}
+		labels[v] = root_labels[root];
+	}
+	free(root_labels);
+	return components_number;
+}
+
+// Strongly Connected Components
+
+/**
+ * Calcola le componenti fortemente connesse del grafo (vedi la nota iniziale) e ne restituisce il numero.
+ * Le componenti sono numerate in ordine topologico inverso: se esiste un arco da u a v in componenti diverse,
+ * allora labels[u] > labels[v]. In particolare, la componente 0 non ha archi uscenti verso altre componenti.
+ *
+ * Durante la visita, labels[v] vale 0 se v non è ancora stato visitato, l'indice di visita (crescente a partire da 1)
+ * se v è in visita o in attesa, e (V - 1 - componente) se la componente di v è stata assegnata: i valori assegnati
+ * sono sempre maggiori degli indici in uso, quindi non influenzano il calcolo dei minimi.
+ */
+int gc_stronglyConnectedComponents(graph* g, int* labels) {
+	int vertices_number = g->vertices_number;
+	int* stack = malloc(((size_t)vertices_number + 1) * sizeof(int));
+	long* cursors = malloc(((size_t)vertices_number + 1) * sizeof(long));
+	uint64_t* roots = calloc((size_t)vertices_number / 64 + 1, sizeof(uint64_t));
+	if (!stack || !cursors || !roots) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		labels[v] = 0;
+	}
+	int index = 1;
+	int component = vertices_number - 1;
+	int waiting = vertices_number;
+	for (int start = 0; start < vertices_number; start++) {
+		if (labels[start] != 0) {
+			continue;
+		}
+		int depth = 0;
+		stack[depth] = start;
+		cursors[depth] = g->offsets[start];
+		labels[start] = index++;
+		roots[start / 64] |= (uint64_t)1 << (start % 64);
+		while (depth >= 0) {
+			int v = stack[depth];
+			if (cursors[depth] < g->offsets[v + 1]) {
+				int w = g->neighbors[cursors[depth]];
+				if (labels[w] == 0) {
+					// Discesa nel vicino: l'arco verrà riconsiderato al ritorno
+					depth++;
+					stack[depth] = w;
+					cursors[depth] = g->offsets[w];
+					labels[w] = index++;
+					roots[w / 64] |= (uint64_t)1 << (w % 64);
+					continue;
+				}
+				if (labels[w] < labels[v]) {
+					labels[v] = labels[w];
+					roots[v / 64] &= ~((uint64_t)1 << (v % 64));
+				}
+				cursors[depth]++;
+				continue;
+			}
+			// Tutti gli archi di v sono stati esaminati
+			if ((roots[v / 64] >> (v % 64)) & 1) {
+				index--;
+				while (waiting < vertices_number && labels[v] <= labels[stack[waiting]]) {
+					labels[stack[waiting++]] = component;
+					index--;
+				}
+				labels[v] = component--;
+			} else {
+				stack[--waiting] = v;
+			}
+			depth--;
+			if (depth >= 0) {
+				int parent = stack[depth];
+				if (labels[v] < labels[parent]) {
+					labels[parent] = labels[v];
+					roots[parent / 64] &= ~((uint64_t)1 << (parent % 64));
+				}
+				cursors[depth]++;
+			}
+		}
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		labels[v] = vertices_number - 1 - labels[v];
+	}
+	free(stack);
+	free(cursors);
+	free(roots);
+	return vertices_number - 1 - component;
+}
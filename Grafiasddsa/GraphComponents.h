@@ -0,0 +1,18 @@
+#ifndef GRAPHCOMPONENTS_H_
+#define GRAPHCOMPONENTS_H_
+
+#include "Graph.h"
+#include "UnionFind.h"
+
+// Connected Components
+int gc_connectedComponents(graph* g, int* labels); // OK
+int gc_parallelConnectedComponents(graph* g, int threads_number, int* labels); // OK
+
+// Incremental Components
+unionfind* gc_initComponents(graph* g); // OK
+int gc_getComponentLabels(unionfind* uf, int* labels); // OK
+
+// Strongly Connected Components
+int gc_stronglyConnectedComponents(graph* g, int* labels); // OK
+
+#endif
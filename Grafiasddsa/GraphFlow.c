@@ -0,0 +1,592 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "GraphFlow.h"
+
+#ifndef INVALID_VERTEX_ERROR
+#	define INVALID_VERTEX_ERROR(instr, vertex) printf("Error: Invalid vertex %d in \"%s\" function.\n", vertex, instr )
+#endif
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#define NO_ARC (-1L)
+#define NO_VERTEX (-1)
+#define NO_LEVEL (-1)
+#define RELATIVE_EPSILON 1e-12
+#define GLOBAL_RELABEL_FREQUENCY 1
+
+/**
+ * Libreria che implementa gli algoritmi di flusso massimo (e taglio minimo) sul grafo CSR.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Le capacità degli archi sono i loro pesi (unitarie se il grafo non è pesato; i pesi negativi valgono come capacità
+ * nulla). In un grafo non orientato ogni arco può essere attraversato in entrambe le direzioni, con la stessa
+ * capacità. I cappi vengono ignorati.
+ *
+ * Entrambi gli algoritmi lavorano su una rete residua in formato CSR (gf_network), costruita dal grafo: ogni arco
+ * (u, v) del grafo diventa un arco "diretto" nella riga di u, con capacità residua pari alla capacità dell'arco, e un
+ * arco "inverso" nella riga di v, con capacità residua nulla. Ogni arco conosce la posizione del suo inverso, e
+ * spingere del flusso su un arco ne diminuisce la capacità residua aumentando quella dell'inverso. Il flusso su un
+ * arco del grafo è quindi la capacità residua del suo arco inverso. Le capacità residue inferiori a una soglia
+ * (RELATIVE_EPSILON volte la capacità massima) sono considerate nulle, per assorbire gli errori di arrotondamento.
+ *
+ * - Dinic: a ogni fase, una visita in ampiezza dalla sorgente sugli archi residui assegna un livello ad ogni vertice;
+ *   poi si cerca un flusso bloccante nel grafo dei livelli (sugli archi che salgono di un livello) con una visita
+ *   in profondità iterativa. Ogni vertice mantiene un puntatore all'arco corrente ("current arc"), che avanza sugli
+ *   archi inutilizzabili e non torna mai indietro durante la fase; i vertici senza uscita vengono esclusi.
+ *   Il numero di fasi è al più V, e ogni fase costa O(V E).
+ * - Push-relabel: ogni vertice ha un'altezza (la sorgente V, il pozzo 0), e i vertici con eccesso di flusso ("attivi")
+ *   lo spingono sugli archi residui verso vertici più bassi di un'unità, oppure si alzano ("relabel") se non ne
+ *   hanno. Viene sempre scaricato il vertice attivo più alto (regola "highest-label", O(V^2 sqrt(E))), usando un
+ *   array di liste di vertici attivi indicizzato per altezza. I vertici di altezza inferiore a V sono anche mantenuti
+ *   in liste per altezza: se un relabel svuota un'altezza ("gap"), i vertici più alti non possono più raggiungere il
+ *   pozzo, e vengono portati subito sopra la sorgente. Inoltre, ogni GLOBAL_RELABEL_FREQUENCY * V relabel, le
+ *   altezze vengono ricalcolate esattamente con una visita in ampiezza all'indietro dal pozzo (e dalla sorgente, per i
+ *   vertici che non raggiungono il pozzo). L'algoritmo termina con un flusso valido: l'eccesso rimasto sopra la
+ *   sorgente vi viene riportato.
+ *
+ * Il taglio minimo si ottiene al termine di entrambi gli algoritmi come l'insieme dei vertici raggiungibili dalla
+ * sorgente nella rete residua: gli archi del grafo che escono da questo insieme ("gf_getCutArcs") sono saturi, e la
+ * somma delle loro capacità è pari al flusso massimo.
+ */
+
+// Static Utility Functions
+
+typedef struct gf_network {
+	int vertices_number;
+	long* offsets;
+	int* heads;
+	long* reverses;
+	double* residuals;
+	long* arcs;
+	double epsilon;
+} gf_network;
+
+typedef struct gf_preflow {
+	gf_network* n;
+	int source;
+	int sink;
+	int* heights;
+	double* excesses;
+	long* currents;
+	int* active_heads;
+	int* active_next;
+	int highest_active;
+	int* level_heads;
+	int* level_next;
+	int* level_previous;
+	int highest_level;
+	int* queue;
+	long relabels;
+} gf_preflow;
+
+/**
+ * Restituisce true se la sorgente o il pozzo non sono validi, stampando un errore.
+ */
+static bool gf_checkTerminals(graph* g, int source, int sink, const char* instr) {
+	if (source < 0 || source >= g->vertices_number) {
+		INVALID_VERTEX_ERROR(instr, source);
+		return true;
+	}
+	if (sink < 0 || sink >= g->vertices_number || sink == source) {
+		INVALID_VERTEX_ERROR(instr, sink);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Costruisce la rete residua del grafo (vedi la nota iniziale).
+ */
+static gf_network* gf_initNetwork(graph* g) {
+	int vertices_number = g->vertices_number;
+	gf_network* n = malloc(sizeof(gf_network));
+	if (!n) {
+		MEMORY_ERROR;
+	}
+	n->vertices_number = vertices_number;
+	n->offsets = calloc((size_t)vertices_number + 1, sizeof(long));
+	long* cursors = malloc((size_t)vertices_number * sizeof(long) + 1);
+	if (!n->offsets || !cursors) {
+		MEMORY_ERROR;
+	}
+	// Conteggio degli archi residui di ogni vertice (uno diretto e uno inverso per arco), in offsets[v + 1]
+	for (int u = 0; u < vertices_number; u++) {
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			int v = g->neighbors[arc];
+			if (v != u) {
+				n->offsets[u + 1]++;
+				n->offsets[v + 1]++;
+			}
+		}
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		n->offsets[v + 1] += n->offsets[v];
+	}
+	long residual_arcs = n->offsets[vertices_number];
+	n->heads = malloc((size_t)residual_arcs * sizeof(int) + 1);
+	n->reverses = malloc((size_t)residual_arcs * sizeof(long) + 1);
+	n->residuals = malloc((size_t)residual_arcs * sizeof(double) + 1);
+	n->arcs = malloc((size_t)residual_arcs * sizeof(long) + 1);
+	if (!n->heads || !n->reverses || !n->residuals || !n->arcs) {
+		MEMORY_ERROR;
+	}
+	memcpy(cursors, n->offsets, (size_t)vertices_number * sizeof(long));
+	double max_capacity = 0;
+	for (int u = 0; u < vertices_number; u++) {
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			int v = g->neighbors[arc];
+			if (v == u) {
+				continue;
+			}
+			double capacity = g->weights ? fmax(g->weights[arc], 0) : 1;
+			long forward = cursors[u]++;
+			long backward = cursors[v]++;
+			n->heads[forward] = v;
+			n->reverses[forward] = backward;
+			n->residuals[forward] = capacity;
+			n->arcs[forward] = arc;
+			n->heads[backward] = u;
+			n->reverses[backward] = forward;
+			n->residuals[backward] = 0;
+			n->arcs[backward] = NO_ARC;
+			max_capacity = fmax(max_capacity, capacity);
+		}
+	}
+	n->epsilon = max_capacity * RELATIVE_EPSILON;
+	free(cursors);
+	return n;
+}
+
+/**
+ * Elimina la rete residua.
+ */
+static void gf_deleteNetwork(gf_network* n) {
+	free(n->offsets);
+	free(n->heads);
+	free(n->reverses);
+	free(n->residuals);
+	free(n->arcs);
+	free(n);
+}
+
+/**
+ * Sposta la quantità di flusso data sull'arco residuo indicato.
+ */
+static inline void gf_pushFlow(gf_network* n, long arc, double delta) {
+	n->residuals[arc] -= delta;
+	n->residuals[n->reverses[arc]] += delta;
+}
+
+/**
+ * Scrive i risultati comuni ai due algoritmi: il flusso su ogni arco del grafo e, tramite una visita in ampiezza
+ * sugli archi residui, il lato della sorgente del taglio minimo. Entrambi gli array sono opzionali.
+ */
+static void gf_writeResults(gf_network* n, graph* g, int source, double* flows, bool* source_side) {
+	int vertices_number = n->vertices_number;
+	if (flows) {
+		memset(flows, 0, (size_t)g->offsets[vertices_number] * sizeof(double));
+		for (long arc = 0; arc < n->offsets[vertices_number]; arc++) {
+			if (n->arcs[arc] != NO_ARC) {
+				flows[n->arcs[arc]] = n->residuals[n->reverses[arc]];
+			}
+		}
+	}
+	if (source_side) {
+		int* queue = malloc((size_t)vertices_number * sizeof(int) + 1);
+		if (!queue) {
+			MEMORY_ERROR;
+		}
+		memset(source_side, 0, (size_t)vertices_number * sizeof(bool));
+		int head = 0;
+		int tail = 0;
+		source_side[source] = true;
+		queue[tail++] = source;
+		while (head < tail) {
+			int u = queue[head++];
+			for (long arc = n->offsets[u]; arc < n->offsets[u + 1]; arc++) {
+				int v = n->heads[arc];
+				if (!source_side[v] && n->residuals[arc] > n->epsilon) {
+					source_side[v] = true;
+					queue[tail++] = v;
+				}
+			}
+		}
+		free(queue);
+	}
+}
+
+/**
+ * Assegna ad ogni vertice la distanza dalla sorgente sugli archi residui (NO_LEVEL se irraggiungibile), fermando la
+ * visita al livello del pozzo. Restituisce true se il pozzo è raggiungibile.
+ */
+static bool gf_buildLevels(gf_network* n, int source, int sink, int* levels, int* queue) {
+	for (int v = 0; v < n->vertices_number; v++) {
+		levels[v] = NO_LEVEL;
+	}
+	int head = 0;
+	int tail = 0;
+	levels[source] = 0;
+	queue[tail++] = source;
+	while (head < tail) {
+		int u = queue[head++];
+		if (levels[sink] != NO_LEVEL && levels[u] >= levels[sink]) {
+			break;
+		}
+		for (long arc = n->offsets[u]; arc < n->offsets[u + 1]; arc++) {
+			int v = n->heads[arc];
+			if (levels[v] == NO_LEVEL && n->residuals[arc] > n->epsilon) {
+				levels[v] = levels[u] + 1;
+				queue[tail++] = v;
+			}
+		}
+	}
+	return levels[sink] != NO_LEVEL;
+}
+
+/**
+ * Calcola un flusso bloccante nel grafo dei livelli con una visita in profondità iterativa: il cammino corrente è
+ * memorizzato come sequenza di archi in "path". Raggiunto il pozzo, il cammino viene aumentato della sua capacità
+ * residua minima e accorciato fino al primo arco saturato; un vertice senza archi utilizzabili viene escluso dalla
+ * fase (il suo livello viene annullato) e la visita torna al vertice precedente. Restituisce il flusso aggiunto.
+ */
+static double gf_blockingFlow(gf_network* n, int source, int sink, int* levels, long* currents, long* path) {
+	double flow = 0;
+	int depth = 0;
+	int u = source;
+	while (true) {
+		if (u == sink) {
+			double bottleneck = INFINITY;
+			for (int i = 0; i < depth; i++) {
+				bottleneck = fmin(bottleneck, n->residuals[path[i]]);
+			}
+			int saturated = depth;
+			for (int i = 0; i < depth; i++) {
+				gf_pushFlow(n, path[i], bottleneck);
+				if (saturated == depth && n->residuals[path[i]] <= n->epsilon) {
+					saturated = i;
+				}
+			}
+			flow += bottleneck;
+			depth = saturated;
+			u = depth == 0 ? source : n->heads[path[depth - 1]];
+			continue;
+		}
+		long end = n->offsets[u + 1];
+		while (currents[u] < end && (n->residuals[currents[u]] <= n->epsilon
+				|| levels[n->heads[currents[u]]] != levels[u] + 1)) {
+			currents[u]++;
+		}
+		if (currents[u] < end) {
+			path[depth++] = currents[u];
+			u = n->heads[currents[u]];
+			continue;
+		}
+		if (u == source) {
+			break;
+		}
+		levels[u] = NO_LEVEL;
+		u = n->heads[n->reverses[path[--depth]]];
+		currents[u]++;
+	}
+	return flow;
+}
+
+/**
+ * Aggiunge un vertice alla lista dei vertici attivi della sua altezza.
+ */
+static void gf_activate(gf_preflow* p, int v) {
+	int height = p->heights[v];
+	p->active_next[v] = p->active_heads[height];
+	p->active_heads[height] = v;
+	if (height > p->highest_active) {
+		p->highest_active = height;
+	}
+}
+
+/**
+ * Aggiunge un vertice (di altezza inferiore a V) alla lista dei vertici della sua altezza.
+ */
+static void gf_addToLevel(gf_preflow* p, int v) {
+	int height = p->heights[v];
+	p->level_previous[v] = NO_VERTEX;
+	p->level_next[v] = p->level_heads[height];
+	if (p->level_heads[height] != NO_VERTEX) {
+		p->level_previous[p->level_heads[height]] = v;
+	}
+	p->level_heads[height] = v;
+	if (height > p->highest_level) {
+		p->highest_level = height;
+	}
+}
+
+/**
+ * Rimuove un vertice (di altezza inferiore a V) dalla lista dei vertici della sua altezza.
+ */
+static void gf_removeFromLevel(gf_preflow* p, int v) {
+	if (p->level_previous[v] != NO_VERTEX) {
+		p->level_next[p->level_previous[v]] = p->level_next[v];
+	} else {
+		p->level_heads[p->heights[v]] = p->level_next[v];
+	}
+	if (p->level_next[v] != NO_VERTEX) {
+		p->level_previous[p->level_next[v]] = p->level_previous[v];
+	}
+}
+
+/**
+ * Visita in ampiezza all'indietro sugli archi residui a partire dal vertice dato, assegnando ai vertici raggiunti
+ * (e non ancora visitati, cioè di altezza "unreached") l'altezza del vertice di partenza più la loro distanza.
+ */
+static void gf_reverseBreadthFirstSearch(gf_preflow* p, int start, int unreached) {
+	gf_network* n = p->n;
+	int head = 0;
+	int tail = 0;
+	p->queue[tail++] = start;
+	while (head < tail) {
+		int w = p->queue[head++];
+		for (long arc = n->offsets[w]; arc < n->offsets[w + 1]; arc++) {
+			int u = n->heads[arc];
+			if (p->heights[u] == unreached && n->residuals[n->reverses[arc]] > n->epsilon) {
+				p->heights[u] = p->heights[w] + 1;
+				p->queue[tail++] = u;
+			}
+		}
+	}
+}
+
+/**
+ * Ricalcola esattamente le altezze (distanza dal pozzo, oppure V più la distanza dalla sorgente) e ricostruisce le
+ * liste dei vertici attivi e dei vertici per altezza.
+ */
+static void gf_globalRelabel(gf_preflow* p) {
+	gf_network* n = p->n;
+	int vertices_number = n->vertices_number;
+	int unreached = 2 * vertices_number;
+	for (int v = 0; v < vertices_number; v++) {
+		p->heights[v] = unreached;
+	}
+	p->heights[p->sink] = 0;
+	gf_reverseBreadthFirstSearch(p, p->sink, unreached);
+	p->heights[p->source] = vertices_number;
+	gf_reverseBreadthFirstSearch(p, p->source, unreached);
+	for (int h = 0; h <= unreached; h++) {
+		p->active_heads[h] = NO_VERTEX;
+	}
+	for (int h = 0; h < vertices_number; h++) {
+		p->level_heads[h] = NO_VERTEX;
+	}
+	p->highest_active = -1;
+	p->highest_level = -1;
+	for (int v = 0; v < vertices_number; v++) {
+		p->currents[v] = n->offsets[v];
+		if (p->heights[v] < vertices_number) {
+			gf_addToLevel(p, v);
+		}
+		if (v != p->source && v != p->sink && p->excesses[v] > n->epsilon && p->heights[v] < unreached) {
+			gf_activate(p, v);
+		}
+	}
+}
+
+/**
+ * Alza il vertice al minimo fra le altezze dei vicini residui più uno. Se il vertice lascia vuota la sua altezza
+ * (inferiore a V), i vertici più alti (tutti inattivi, data la regola highest-label) vengono portati ad altezza V + 1.
+ */
+static void gf_relabel(gf_preflow* p, int u) {
+	gf_network* n = p->n;
+	int vertices_number = n->vertices_number;
+	int old_height = p->heights[u];
+	if (old_height < vertices_number) {
+		gf_removeFromLevel(p, u);
+		if (p->level_heads[old_height] == NO_VERTEX) {
+			for (int h = old_height + 1; h <= p->highest_level; h++) {
+				for (int v = p->level_heads[h]; v != NO_VERTEX; v = p->level_next[v]) {
+					p->heights[v] = vertices_number + 1;
+					p->currents[v] = n->offsets[v];
+				}
+				p->level_heads[h] = NO_VERTEX;
+			}
+			p->highest_level = old_height - 1;
+		}
+	}
+	int height = 2 * vertices_number;
+	for (long arc = n->offsets[u]; arc < n->offsets[u + 1]; arc++) {
+		if (n->residuals[arc] > n->epsilon && p->heights[n->heads[arc]] + 1 < height) {
+			height = p->heights[n->heads[arc]] + 1;
+		}
+	}
+	p->heights[u] = height;
+	p->currents[u] = n->offsets[u];
+	if (height < vertices_number) {
+		gf_addToLevel(p, u);
+	}
+	p->relabels++;
+}
+
+/**
+ * Scarica un vertice attivo: spinge il suo eccesso sugli archi ammissibili (verso vicini più bassi di un'unità),
+ * a partire dall'arco corrente, e lo alza quando gli archi sono esauriti.
+ */
+static void gf_discharge(gf_preflow* p, int u) {
+	gf_network* n = p->n;
+	int unreached = 2 * n->vertices_number;
+	while (p->excesses[u] > n->epsilon) {
+		if (p->currents[u] == n->offsets[u + 1]) {
+			gf_relabel(p, u);
+			if (p->heights[u] >= unreached) {
+				break;
+			}
+			continue;
+		}
+		long arc = p->currents[u];
+		int v = n->heads[arc];
+		if (n->residuals[arc] > n->epsilon && p->heights[u] == p->heights[v] + 1) {
+			double delta = fmin(p->excesses[u], n->residuals[arc]);
+			if (p->excesses[v] <= n->epsilon && v != p->source && v != p->sink) {
+				gf_activate(p, v);
+			}
+			gf_pushFlow(n, arc, delta);
+			p->excesses[u] -= delta;
+			p->excesses[v] += delta;
+		} else {
+			p->currents[u]++;
+		}
+	}
+}
+
+// Maximum Flow
+
+/**
+ * Calcola il flusso massimo dalla sorgente al pozzo con l'algoritmo di Dinic (vedi la nota iniziale), e ne restituisce
+ * il valore, oppure -1 se i vertici non sono validi (o coincidono).
+ * Se l'array "flows" non è NULL (di lunghezza pari al numero di archi memorizzati, "gr_getArcsNumber"), vi viene
+ * scritto il flusso su ogni arco del grafo; se l'array "source_side" non è NULL (di lunghezza pari al numero di
+ * vertici), vi viene scritto il lato della sorgente del taglio minimo.
+ */
+double gf_dinic(graph* g, int source, int sink, double* flows, bool* source_side) {
+	if (gf_checkTerminals(g, source, sink, "gf_dinic")) {
+		return -1;
+	}
+	int vertices_number = g->vertices_number;
+	gf_network* n = gf_initNetwork(g);
+	int* levels = malloc((size_t)vertices_number * sizeof(int));
+	int* queue = malloc((size_t)vertices_number * sizeof(int));
+	long* currents = malloc((size_t)vertices_number * sizeof(long));
+	long* path = malloc((size_t)vertices_number * sizeof(long));
+	if (!levels || !queue || !currents || !path) {
+		MEMORY_ERROR;
+	}
+	double max_flow = 0;
+	while (gf_buildLevels(n, source, sink, levels, queue)) {
+		memcpy(currents, n->offsets, (size_t)vertices_number * sizeof(long));
+		max_flow += gf_blockingFlow(n, source, sink, levels, currents, path);
+	}
+	gf_writeResults(n, g, source, flows, source_side);
+	free(levels);
+	free(queue);
+	free(currents);
+	free(path);
+	gf_deleteNetwork(n);
+	return max_flow;
+}
+
+/**
+ * Calcola il flusso massimo dalla sorgente al pozzo con l'algoritmo push-relabel (vedi la nota iniziale), e ne
+ * restituisce il valore, oppure -1 se i vertici non sono validi (o coincidono). Gli array "flows" e "source_side"
+ * sono opzionali, come per "gf_dinic".
+ */
+double gf_pushRelabel(graph* g, int source, int sink, double* flows, bool* source_side) {
+	if (gf_checkTerminals(g, source, sink, "gf_pushRelabel")) {
+		return -1;
+	}
+	int vertices_number = g->vertices_number;
+	gf_preflow p;
+	p.n = gf_initNetwork(g);
+	p.source = source;
+	p.sink = sink;
+	p.heights = malloc((size_t)vertices_number * sizeof(int));
+	p.excesses = calloc((size_t)vertices_number, sizeof(double));
+	p.currents = malloc((size_t)vertices_number * sizeof(long));
+	p.active_heads = malloc((2 * (size_t)vertices_number + 1) * sizeof(int));
+	p.active_next = malloc((size_t)vertices_number * sizeof(int));
+	p.level_heads = malloc((size_t)vertices_number * sizeof(int));
+	p.level_next = malloc((size_t)vertices_number * sizeof(int));
+	p.level_previous = malloc((size_t)vertices_number * sizeof(int));
+	p.queue = malloc((size_t)vertices_number * sizeof(int));
+	if (!p.heights || !p.excesses || !p.currents || !p.active_heads || !p.active_next || !p.level_heads
+			|| !p.level_next || !p.level_previous || !p.queue) {
+		MEMORY_ERROR;
+	}
+	// Saturazione degli archi uscenti dalla sorgente
+	gf_network* n = p.n;
+	for (long arc = n->offsets[source]; arc < n->offsets[source + 1]; arc++) {
+		double delta = n->residuals[arc];
+		if (delta > 0) {
+			gf_pushFlow(n, arc, delta);
+			p.excesses[source] -= delta;
+			p.excesses[n->heads[arc]] += delta;
+		}
+	}
+	gf_globalRelabel(&p);
+	p.relabels = 0;
+	while (true) {
+		while (p.highest_active >= 0 && p.active_heads[p.highest_active] == NO_VERTEX) {
+			p.highest_active--;
+		}
+		if (p.highest_active < 0) {
+			break;
+		}
+		int u = p.active_heads[p.highest_active];
+		p.active_heads[p.highest_active] = p.active_next[u];
+		gf_discharge(&p, u);
+		if (p.relabels >= (long)GLOBAL_RELABEL_FREQUENCY * vertices_number) {
+			p.relabels = 0;
+			gf_globalRelabel(&p);
+		}
+	}
+	double max_flow = p.excesses[sink];
+	gf_writeResults(n, g, source, flows, source_side);
+	free(p.heights);
+	free(p.excesses);
+	free(p.currents);
+	free(p.active_heads);
+	free(p.active_next);
+	free(p.level_heads);
+	free(p.level_next);
+	free(p.level_previous);
+	free(p.queue);
+	gf_deleteNetwork(n);
+	return max_flow;
+}
+
+// Minimum Cut
+
+/**
+ * Scrive nell'array "cut_arcs" (se non è NULL) le posizioni degli archi del grafo che escono dal lato della
+ * sorgente del taglio (calcolato da "gf_dinic" o "gf_pushRelabel"), e ne restituisce il numero.
+ * In un grafo non orientato ogni arco del taglio compare una sola volta, nella direzione che esce dal lato della
+ * sorgente.
+ */
+long gf_getCutArcs(graph* g, bool* source_side, long* cut_arcs) {
+	long cut_size = 0;
+	for (int u = 0; u < g->vertices_number; u++) {
+		if (!source_side[u]) {
+			continue;
+		}
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			if (!source_side[g->neighbors[arc]]) {
+				if (cut_arcs) {
+					cut_arcs[cut_size] = arc;
+				}
+				cut_size++;
+			}
+		}
+	}
+	return cut_size;
+}
@@ -0,0 +1,13 @@
+#ifndef GRAPHFLOW_H_
+#define GRAPHFLOW_H_
+
+#include "Graph.h"
+
+// Maximum Flow
+double gf_dinic(graph* g, int source, int sink, double* flows, bool* source_side); // OK
+double gf_pushRelabel(graph* g, int source, int sink, double* flows, bool* source_side); // OK
+
+// Minimum Cut
+long gf_getCutArcs(graph* g, bool* source_side, long* cut_arcs); // OK
+
+#endif
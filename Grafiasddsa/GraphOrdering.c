@@ -0,0 +1,369 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "GraphOrdering.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#define UNORDERED (-1)
+#define PERIPHERAL_SEARCH_ROUNDS 4
+
+/**
+ * Libreria che implementa gli ordinamenti dei vertici del grafo CSR volti a migliorare la località in memoria.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Se gli indici dei vertici sono sparsi a caso, ogni arco percorso da una visita porta ad un accesso casuale negli
+ * array indicizzati per vertice (distanze, ranghi, righe del CSR), e le visite sono limitate dai cache miss.
+ * Rinumerando i vertici in modo che i vertici vicini nel grafo abbiano indici vicini, gran parte di questi accessi
+ * cade nelle stesse linee di cache. Gli ordinamenti disponibili sono:
+ * - per grado decrescente: i vertici più visitati (gli hub) vengono raccolti in poche linee di cache;
+ * - in ampiezza: i vertici sono numerati nell'ordine di una visita in ampiezza;
+ * - Cuthill-McKee inverso: come la visita in ampiezza, ma partendo da un vertice periferico e visitando i vicini
+ *   in ordine di grado crescente, e invertendo infine l'ordine; minimizza l'ampiezza di banda della matrice di
+ *   adiacenza, ossia la massima distanza fra gli indici di due vertici adiacenti.
+ *
+ * Ogni funzione scrive nell'array "permutation" (fornito dal chiamante) il nuovo indice di ogni vertice, da passare a
+ * "gr_permuteGraph" per costruire il grafo rinumerato (e la corrispondenza inversa con gli indici originali).
+ * Le visite sono ripetute da ogni vertice non ancora raggiunto, in modo da coprire tutte le componenti; per un grafo
+ * orientato vengono seguiti solamente gli archi uscenti.
+ */
+
+// Static Utility Functions
+
+/**
+ * Restituisce il grado uscente di un vertice, senza controlli.
+ */
+static long go_getDegree(graph* g, int vertex) {
+	return g->offsets[vertex + 1] - g->offsets[vertex];
+}
+
+/**
+ * Confronta due chiavi a 64 bit, per l'ordinamento dei vicini.
+ */
+static int go_compareKeys(const void* first, const void* second) {
+	uint64_t a = *(const uint64_t*)first;
+	uint64_t b = *(const uint64_t*)second;
+	return (a > b) - (a < b);
+}
+
+/**
+ * Visita in ampiezza a partire dalla sorgente, che accoda i vertici non ancora ordinati nell'array "order" a partire
+ * dalla posizione "tail", e ne restituisce la nuova lunghezza. Se "keys" non è NULL, i vicini scoperti da ogni vertice
+ * vengono accodati in ordine di grado crescente (usando "keys" come spazio di lavoro, di lunghezza pari al numero
+ * di vertici). L'array "positions" associa ad ogni vertice la sua posizione in "order", oppure UNORDERED.
+ */
+static int go_appendBreadthFirst(graph* g, int source, int* order, int tail, int* positions, uint64_t* keys) {
+	int head = tail;
+	positions[source] = tail;
+	order[tail++] = source;
+	while (head < tail) {
+		int u = order[head++];
+		int first = tail;
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			int v = g->neighbors[arc];
+			if (positions[v] == UNORDERED) {
+				positions[v] = tail;
+				order[tail++] = v;
+			}
+		}
+		if (keys && tail - first > 1) {
+			for (int i = first; i < tail; i++) {
+				keys[i - first] = ((uint64_t)go_getDegree(g, order[i]) << 32) | (uint32_t)order[i];
+			}
+			qsort(keys, tail - first, sizeof(uint64_t), go_compareKeys);
+			for (int i = first; i < tail; i++) {
+				order[i] = (int)(uint32_t)keys[i - first];
+				positions[order[i]] = i;
+			}
+		}
+	}
+	return tail;
+}
+
+/**
+ * Annulla le posizioni dei vertici nell'intervallo [begin, end) dell'ordine, in modo che possano essere rivisitati.
+ */
+static void go_resetPositions(int* order, int begin, int end, int* positions) {
+	for (int i = begin; i < end; i++) {
+		positions[order[i]] = UNORDERED;
+	}
+}
+
+/**
+ * Cerca un vertice pseudo-periferico della componente della sorgente (euristica di George e Liu): ripete la visita
+ * in ampiezza partendo dal vertice di grado minimo dell'ultimo livello, finché la profondità della visita cresce.
+ * Al termine, le posizioni dei vertici visitati vengono annullate.
+ */
+static int go_findPeripheralVertex(graph* g, int source, int* order, int tail, int* positions, int* levels) {
+	int best_depth = -1;
+	for (int round = 0; round < PERIPHERAL_SEARCH_ROUNDS; round++) {
+		int end = go_appendBreadthFirst(g, source, order, tail, positions, NULL);
+		// I livelli vengono ricostruiti sull'ordine di visita, in cui i vertici compaiono per livello crescente
+		levels[source] = 0;
+		for (int i = tail; i < end; i++) {
+			int u = order[i];
+			for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+				int v = g->neighbors[arc];
+				if (positions[v] > i && v != source && levels[v] == -1) {
+					levels[v] = levels[u] + 1;
+				}
+			}
+		}
+		int depth = levels[order[end - 1]];
+		int candidate = order[end - 1];
+		for (int i = end - 1; i >= tail && levels[order[i]] == depth; i--) {
+			if (go_getDegree(g, order[i]) < go_getDegree(g, candidate)) {
+				candidate = order[i];
+			}
+		}
+		for (int i = tail; i < end; i++) {
+			levels[order[i]] = -1;
+		}
+		go_resetPositions(order, tail, end, positions);
+		if (depth <= best_depth) {
+			break;
+		}
+		best_depth = depth;
+		source = candidate;
+	}
+	return source;
+}
+
+/**
+ * Alloca l'array delle posizioni, con tutti i vertici non ordinati.
+ */
+static int* go_initPositions(int vertices_number) {
+	int* positions = malloc((size_t)vertices_number * sizeof(int) + 1);
+	if (!positions) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		positions[v] = UNORDERED;
+	}
+	return positions;
+}
+
+// Vertex Orderings
+
+/**
+ * Ordina i vertici per grado (uscente) decrescente, a parità di grado secondo l'indice originale.
+ * L'ordinamento è un counting sort sui gradi, in tempo O(V + grado massimo).
+ */
+void go_degreeOrdering(graph* g, int* permutation) {
+	int vertices_number = g->vertices_number;
+	long max_degree = 0;
+	for (int v = 0; v < vertices_number; v++) {
+		if (go_getDegree(g, v) > max_degree) {
+			max_degree = go_getDegree(g, v);
+		}
+	}
+	long* counts = calloc((size_t)max_degree + 2, sizeof(long));
+	if (!counts) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		counts[max_degree - go_getDegree(g, v) + 1]++;
+	}
+	for (long d = 0; d <= max_degree; d++) {
+		counts[d + 1] += counts[d];
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		permutation[v] = (int)counts[max_degree - go_getDegree(g, v)]++;
+	}
+	free(counts);
+}
+
+/**
+ * Ordina i vertici secondo una visita in ampiezza, ripetuta dal vertice di indice minimo non ancora raggiunto.
+ */
+void go_breadthFirstOrdering(graph* g, int* permutation) {
+	int vertices_number = g->vertices_number;
+	int* positions = go_initPositions(vertices_number);
+	int tail = 0;
+	for (int v = 0; v < vertices_number; v++) {
+		if (positions[v] == UNORDERED) {
+			tail = go_appendBreadthFirst(g, v, permutation, tail, positions, NULL);
+		}
+	}
+	// L'ordine di visita è la permutazione inversa: le posizioni sono la permutazione cercata
+	for (int v = 0; v < vertices_number; v++) {
+		permutation[v] = positions[v];
+	}
+	free(positions);
+}
+
+/**
+ * Ordina i vertici con l'algoritmo Cuthill-McKee inverso (vedi la nota iniziale). Ogni componente viene visitata
+ * a partire da un vertice pseudo-periferico, cercato a partire dal vertice di grado minimo non ancora raggiunto.
+ */
+void go_reverseCuthillMcKeeOrdering(graph* g, int* permutation) {
+	int vertices_number = g->vertices_number;
+	int* positions = go_initPositions(vertices_number);
+	int* order = malloc((size_t)vertices_number * sizeof(int) + 1);
+	int* by_degree = malloc((size_t)vertices_number * sizeof(int) + 1);
+	int* levels = malloc((size_t)vertices_number * sizeof(int) + 1);
+	uint64_t* keys = malloc((size_t)vertices_number * sizeof(uint64_t) + 1);
+	if (!order || !by_degree || !levels || !keys) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		levels[v] = -1;
+	}
+	// I vertici vengono scorsi per grado crescente, per scegliere il punto di partenza di ogni componente
+	go_degreeOrdering(g, permutation);
+	for (int v = 0; v < vertices_number; v++) {
+		by_degree[vertices_number - 1 - permutation[v]] = v;
+	}
+	int tail = 0;
+	for (int i = 0; i < vertices_number; i++) {
+		// In un grafo orientato il vertice periferico può non raggiungere il vertice di partenza: in tal caso la
+		// ricerca viene ripetuta dallo stesso vertice, finché non viene ordinato (ogni visita ordina almeno un vertice)
+		while (positions[by_degree[i]] == UNORDERED) {
+			int start = go_findPeripheralVertex(g, by_degree[i], order, tail, positions, levels);
+			tail = go_appendBreadthFirst(g, start, order, tail, positions, keys);
+		}
+	}
+	if (tail != vertices_number) {
+		printf("Error: Incomplete ordering in \"go_reverseCuthillMcKeeOrdering\" function.\n");
+		exit(1);
+	}
+	for (int i = 0; i < vertices_number; i++) {
+		permutation[order[i]] = vertices_number - 1 - i;
+	}
+	free(positions);
+	free(order);
+	free(by_degree);
+	free(levels);
+	free(keys);
+}
+
+///////////////////////// MAIN //////////////////////////////
+
+// Verifiche degli ordinamenti, compilate solamente con l'opzione -DGRAPH_ORDERING_TESTING
+#ifdef GRAPH_ORDERING_TESTING
+
+typedef struct {
+	int neighbor;
+	double weight;
+} checked_arc;
+
+/**
+ * Confronta due archi per vicino e poi per peso, per ordinare le liste di vicini da confrontare.
+ */
+static int compareCheckedArcs(const void* first, const void* second) {
+	const checked_arc* a = (const checked_arc*)first;
+	const checked_arc* b = (const checked_arc*)second;
+	if (a->neighbor != b->neighbor) {
+		return (a->neighbor > b->neighbor) - (a->neighbor < b->neighbor);
+	}
+	return (a->weight > b->weight) - (a->weight < b->weight);
+}
+
+/**
+ * Scrive nell'array gli archi uscenti dal vertice (con i vicini eventualmente rinumerati), ordinati.
+ */
+static int collectArcs(graph* g, int vertex, int* permutation, checked_arc* arcs) {
+	int degree = 0;
+	for (long arc = g->offsets[vertex]; arc < g->offsets[vertex + 1]; arc++, degree++) {
+		int neighbor = g->neighbors[arc];
+		arcs[degree].neighbor = permutation ? permutation[neighbor] : neighbor;
+		arcs[degree].weight = g->weights ? g->weights[arc] : 1.0;
+	}
+	qsort(arcs, degree, sizeof(checked_arc), compareCheckedArcs);
+	return degree;
+}
+
+/**
+ * Verifica che il grafo rinumerato conservi gli archi: i vicini (con i pesi) di ogni vertice rinumerato devono essere
+ * esattamente i vicini rinumerati del vertice originale.
+ */
+static bool checkPermutedGraph(graph* g, graph* permuted, int* permutation) {
+	int vertices_number = g->vertices_number;
+	long arcs_number = gr_getArcsNumber(g);
+	checked_arc* expected = malloc((size_t)arcs_number * sizeof(checked_arc) + 1);
+	checked_arc* found = malloc((size_t)arcs_number * sizeof(checked_arc) + 1);
+	bool valid = gr_getArcsNumber(permuted) == arcs_number;
+	for (int v = 0; v < vertices_number && valid; v++) {
+		int degree = collectArcs(g, v, permutation, expected);
+		valid = collectArcs(permuted, permutation[v], NULL, found) == degree;
+		for (int i = 0; i < degree && valid; i++) {
+			valid = compareCheckedArcs(&expected[i], &found[i]) == 0;
+		}
+	}
+	free(expected);
+	free(found);
+	return valid;
+}
+
+/**
+ * Verifica che l'array sia una permutazione dei vertici, e che il grafo rinumerato conservi gli archi.
+ */
+static bool checkPermutation(graph* g, int* permutation) {
+	int vertices_number = g->vertices_number;
+	bool* used = calloc((size_t)vertices_number + 1, sizeof(bool));
+	for (int v = 0; v < vertices_number; v++) {
+		if (permutation[v] < 0 || permutation[v] >= vertices_number || used[permutation[v]]) {
+			free(used);
+			return false;
+		}
+		used[permutation[v]] = true;
+	}
+	free(used);
+	graph* permuted = gr_permuteGraph(g, permutation, NULL);
+	bool valid = checkPermutedGraph(g, permuted, permutation);
+	gr_deleteGraph(permuted);
+	return valid;
+}
+
+int main(void) {
+	// Grafi orientati in cui il vertice pseudo-periferico non raggiunge il vertice da cui è partita la ricerca
+	int first_sources[] = {3, 0, 0, 0, 0, 0, 2, 2};
+	int first_destinations[] = {0, 0, 1, 1, 1, 2, 1, 2};
+	int second_sources[] = {0, 3, 0, 2, 1, 1};
+	int second_destinations[] = {0, 1, 3, 1, 1, 1};
+	double second_weights[] = {0.5, 1.5, 2.5, 3.5, 4.5, 5.5};
+	graph* graphs[] = {
+		gr_initGraphFromEdges(4, 8, first_sources, first_destinations, NULL, true),
+		gr_initGraphFromEdges(4, 8, first_sources, first_destinations, NULL, false),
+		gr_initGraphFromEdges(4, 6, second_sources, second_destinations, second_weights, true),
+		gr_initGraphFromEdges(4, 6, second_sources, second_destinations, second_weights, false)
+	};
+	int permutation[4];
+	int errors = 0;
+	for (int i = 0; i < 4; i++) {
+		const char* kind = graphs[i]->directed ? "orientato" : "non orientato";
+		bool valid;
+		go_degreeOrdering(graphs[i], permutation);
+		valid = checkPermutation(graphs[i], permutation);
+		errors += !valid;
+		printf("Grafo %d (%s), ordinamento per grado: %s\n", i, kind, valid ? "OK" : "ERRORE");
+		go_breadthFirstOrdering(graphs[i], permutation);
+		valid = checkPermutation(graphs[i], permutation);
+		errors += !valid;
+		printf("Grafo %d (%s), ordinamento in ampiezza: %s\n", i, kind, valid ? "OK" : "ERRORE");
+		go_reverseCuthillMcKeeOrdering(graphs[i], permutation);
+		valid = checkPermutation(graphs[i], permutation);
+		errors += !valid;
+		printf("Grafo %d (%s), ordinamento Cuthill-McKee inverso: %s\n", i, kind, valid ? "OK" : "ERRORE");
+		gr_deleteGraph(graphs[i]);
+	}
+	// La verifica deve accorgersi di una rinumerazione errata che conserva i gradi
+	int path_sources[] = {0, 1, 2};
+	int path_destinations[] = {1, 2, 3};
+	int wrong_destinations[] = {2, 3, 1};
+	int identity[] = {0, 1, 2, 3};
+	graph* path = gr_initGraphFromEdges(4, 3, path_sources, path_destinations, NULL, true);
+	graph* wrong = gr_initGraphFromEdges(4, 3, path_sources, wrong_destinations, NULL, true);
+	bool detected = !checkPermutedGraph(path, wrong, identity);
+	errors += !detected;
+	printf("Rinumerazione errata con gli stessi gradi: %s\n", detected ? "OK" : "ERRORE");
+	gr_deleteGraph(wrong);
+	gr_deleteGraph(path);
+	return errors != 0;
+}
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef GRAPHORDERING_H_
+#define GRAPHORDERING_H_
+
+#include "Graph.h"
+
+// Vertex Orderings
+void go_degreeOrdering(graph* g, int* permutation); // OK
+void go_breadthFirstOrdering(graph* g, int* permutation); // OK
+void go_reverseCuthillMcKeeOrdering(graph* g, int* permutation); // OK
+
+#endif
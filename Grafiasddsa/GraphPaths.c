@@ -0,0 +1,612 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "GraphPaths.h"
+#include "ThreadPool.h"
+
+#ifndef INVALID_VERTEX_ERROR
+#	define INVALID_VERTEX_ERROR(instr, vertex) printf("Error: Invalid vertex %d in \"%s\" function.\n", vertex, instr )
+#endif
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#define NO_TARGET (-1)
+#define FRONTIER_CHUNK 64
+#define INITIAL_BUFFER_CAPACITY 64
+
+/**
+ * Libreria che implementa gli algoritmi di cammino minimo da sorgente singola (o multipla) sul grafo CSR.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Tutte le funzioni condividono la stessa ricerca, basata sull'algoritmo di Dijkstra ed implementata con un
+ * indexedheap: ogni vertice compare nell'heap al più una volta, e il miglioramento della sua distanza provvisoria
+ * corrisponde ad una promozione (decrease-key). Le varianti sono:
+ * - sorgente singola o multipla (la distanza di un vertice è quella dalla sorgente più vicina);
+ * - raggio limitato: la ricerca si ferma ai vertici con distanza non superiore al raggio;
+ * - A*: la priorità di un vertice è la distanza provvisoria più una stima (euristica) della distanza dal bersaglio,
+ *   e la ricerca si ferma non appena il bersaglio viene estratto dall'heap.
+ *
+ * I risultati vengono scritti negli array "distances" e "parents" forniti dal chiamante, di lunghezza pari al numero
+ * di vertici: le funzioni non effettuano allocazioni oltre all'heap. I vertici non raggiunti hanno distanza INFINITY
+ * e padre NO_PARENT, così come le sorgenti. L'array "parents" è opzionale (può essere NULL).
+ * Ogni chiamata di queste funzioni alloca l'heap e inizializza gli array in tempo O(V), anche se la ricerca raggiunge
+ * pochi vertici. Per eseguire molte ricerche sullo stesso grafo conviene quindi usare un contesto di ricerca
+ * (gp_search_context), che possiede l'heap e gli array dei risultati e li riutilizza fra una ricerca e l'altra:
+ * al termine di ogni ricerca vengono ripristinati solamente i vertici toccati (registrati nell'array "touched"),
+ * per cui il costo di una ricerca dipende solamente dalla porzione di grafo che esplora.
+ *
+ * La versione parallela ("gp_deltaStepping") segue l'algoritmo delta-stepping (Meyer e Sanders): i vertici vengono
+ * raccolti in "bucket" di ampiezza delta in base alla loro distanza provvisoria, e i bucket vengono elaborati in ordine.
+ * Gli archi sono divisi in leggeri (peso non superiore a delta) e pesanti: i leggeri possono reinserire vertici nel
+ * bucket corrente, e vengono rilassati ripetutamente finché il bucket non si svuota; i pesanti portano sempre a bucket
+ * successivi, e vengono rilassati una volta sola per ogni vertice uscito dal bucket, alla sua distanza definitiva.
+ * La divisione avviene durante la scansione di ogni riga, senza copiare il grafo: l'algoritmo tocca solo gli archi
+ * dei vertici raggiunti. Tutti i vertici di un bucket
+ * vengono elaborati in parallelo, e le distanze vengono aggiornate con un minimo atomico (compare-and-swap).
+ * Con delta piccolo l'algoritmo si avvicina a Dijkstra (molti bucket, poco lavoro ripetuto); con delta grande
+ * a Bellman-Ford (pochi bucket, molto parallelismo, ma più rilassamenti).
+ * Ogni bucket richiede spesso molti passi leggeri con poco lavoro ciascuno: i thread vengono quindi creati una volta
+ * sola per ogni invocazione, e restano in attesa fra un passo e il successivo (vedi "ThreadPool.h").
+ *
+ * <i>NOTA:</i> I pesi degli archi devono essere non negativi. Se il grafo non è pesato, ogni arco ha peso unitario.
+ */
+
+/*
+typedef struct gp_search_context {
+	graph* g;
+	indexedheap* frontier;
+	double* distances;
+	int* parents;
+	int* touched;
+	int touched_size;
+} gp_search_context;
+*/
+
+// Static Utility Functions
+
+/**
+ * Ricerca comune a tutte le varianti. Restituisce il numero di vertici estratti dall'heap (ossia "definitivi").
+ * L'heap è un max-heap, quindi le priorità vengono inserite cambiate di segno.
+ * Se l'euristica non è consistente un vertice può essere estratto più volte: in tal caso viene reinserito,
+ * come previsto da A*.
+ * Gli array "distances" e "parents" devono essere già inizializzati (a INFINITY e NO_PARENT) e l'heap deve essere
+ * vuoto; al termine l'heap viene svuotato. Se "touched" non è NULL, vi vengono aggiunti i vertici la cui distanza
+ * passa da INFINITY ad un valore finito, ciascuno una volta sola.
+ */
+static int gp_search(graph* g, indexedheap* frontier, int* sources, int sources_number, int target, double radius,
+		double (*heuristic)(int, int, void*), void* context, double* distances, int* parents,
+		int* touched, int* touched_size) {
+	int vertices_number = g->vertices_number;
+	for (int i = 0; i < sources_number; i++) {
+		int source = sources[i];
+		if (source < 0 || source >= vertices_number) {
+			INVALID_VERTEX_ERROR("gp_search", source);
+			continue;
+		}
+		if (touched && distances[source] == INFINITY) {
+			touched[(*touched_size)++] = source;
+		}
+		distances[source] = 0;
+		double estimate = heuristic ? heuristic(source, target, context) : 0;
+		ih_insertOrPromoteItem(frontier, source, -estimate);
+	}
+	int settled = 0;
+	long* offsets = g->offsets;
+	int* neighbors = g->neighbors;
+	double* weights = g->weights;
+	while (ih_getHeapSize(frontier) > 0) {
+		int u = ih_extractRootItem(frontier, NULL);
+		settled++;
+		if (u == target) {
+			break;
+		}
+		double base = distances[u];
+		for (long arc = offsets[u]; arc < offsets[u + 1]; arc++) {
+			int v = neighbors[arc];
+			double candidate = base + (weights ? weights[arc] : 1.0);
+			if (candidate < distances[v] && candidate <= radius) {
+				if (touched && distances[v] == INFINITY) {
+					touched[(*touched_size)++] = v;
+				}
+				distances[v] = candidate;
+				if (parents) {
+					parents[v] = u;
+				}
+				double estimate = heuristic ? heuristic(v, target, context) : 0;
+				ih_insertOrPromoteItem(frontier, v, -(candidate + estimate));
+			}
+		}
+	}
+	ih_clearHeap(frontier);
+	return settled;
+}
+
+/**
+ * Esegue una singola ricerca sugli array forniti dal chiamante, inizializzandoli e allocando un heap temporaneo.
+ */
+static int gp_searchOnce(graph* g, int* sources, int sources_number, int target, double radius,
+		double (*heuristic)(int, int, void*), void* context, double* distances, int* parents) {
+	int vertices_number = g->vertices_number;
+	for (int v = 0; v < vertices_number; v++) {
+		distances[v] = INFINITY;
+	}
+	if (parents) {
+		for (int v = 0; v < vertices_number; v++) {
+			parents[v] = NO_PARENT;
+		}
+	}
+	indexedheap* frontier = ih_initHeap(vertices_number);
+	int settled = gp_search(g, frontier, sources, sources_number, target, radius, heuristic, context,
+		distances, parents, NULL, NULL);
+	ih_deleteHeap(frontier);
+	return settled;
+}
+
+/**
+ * Ripristina i vertici toccati dalla ricerca precedente del contesto, in tempo proporzionale al loro numero.
+ */
+static void gp_resetSearchContext(gp_search_context* c) {
+	for (int i = 0; i < c->touched_size; i++) {
+		c->distances[c->touched[i]] = INFINITY;
+		c->parents[c->touched[i]] = NO_PARENT;
+	}
+	c->touched_size = 0;
+}
+
+typedef struct gp_delta_state {
+	graph* g;
+	double delta;
+	double* distances;
+	double* relaxed_distances;
+	int* frontier;
+	int frontier_size;
+	long bucket;
+	threadpool* pool;
+} gp_delta_state;
+
+typedef struct gp_delta_worker {
+	gp_delta_state* state;
+	int** bins;
+	int* bin_sizes;
+	int* bin_capacities;
+	long bins_number;
+	int* removed;
+	int removed_size;
+	int removed_capacity;
+} gp_delta_worker;
+
+/**
+ * Aggiunge un vertice ad un array dinamico, raddoppiandone la capacità quando necessario.
+ */
+static void gp_pushVertex(int** array, int* size, int* capacity, int vertex) {
+	if (*size == *capacity) {
+		*capacity = *capacity ? *capacity * 2 : INITIAL_BUFFER_CAPACITY;
+		*array = realloc(*array, (size_t)*capacity * sizeof(int));
+		if (!*array) {
+			MEMORY_ERROR;
+		}
+	}
+	(*array)[(*size)++] = vertex;
+}
+
+/**
+ * Aggiunge un vertice al bucket locale di indice dato, allocando i bucket mancanti.
+ */
+static void gp_pushToBin(gp_delta_worker* w, long bin, int vertex) {
+	if (bin >= w->bins_number) {
+		long bins_number = w->bins_number ? w->bins_number : 1;
+		while (bins_number <= bin) {
+			bins_number *= 2;
+		}
+		w->bins = realloc(w->bins, bins_number * sizeof(int*));
+		w->bin_sizes = realloc(w->bin_sizes, bins_number * sizeof(int));
+		w->bin_capacities = realloc(w->bin_capacities, bins_number * sizeof(int));
+		if (!w->bins || !w->bin_sizes || !w->bin_capacities) {
+			MEMORY_ERROR;
+		}
+		for (long i = w->bins_number; i < bins_number; i++) {
+			w->bins[i] = NULL;
+			w->bin_sizes[i] = 0;
+			w->bin_capacities[i] = 0;
+		}
+		w->bins_number = bins_number;
+	}
+	gp_pushVertex(&w->bins[bin], &w->bin_sizes[bin], &w->bin_capacities[bin], vertex);
+}
+
+/**
+ * Legge atomicamente una distanza.
+ */
+static double gp_loadDistance(double* address) {
+	double value;
+	__atomic_load(address, &value, __ATOMIC_RELAXED);
+	return value;
+}
+
+/**
+ * Sostituisce atomicamente la distanza con il valore dato, se minore. Restituisce true se la distanza è cambiata.
+ */
+static bool gp_atomicMin(double* address, double value) {
+	double current = gp_loadDistance(address);
+	while (value < current) {
+		if (__atomic_compare_exchange(address, &current, &value, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Rilassa gli archi leggeri (o pesanti) di un vertice, inserendo nei bucket locali i vertici migliorati.
+ */
+static void gp_relaxArcs(gp_delta_worker* w, int u, bool light) {
+	gp_delta_state* s = w->state;
+	graph* g = s->g;
+	double base = gp_loadDistance(&s->distances[u]);
+	for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+		double weight = g->weights ? g->weights[arc] : 1.0;
+		if ((weight <= s->delta) != light) {
+			continue;
+		}
+		int v = g->neighbors[arc];
+		double candidate = base + weight;
+		if (gp_atomicMin(&s->distances[v], candidate)) {
+			gp_pushToBin(w, (long)(candidate / s->delta), v);
+		}
+	}
+}
+
+/**
+ * Passo leggero: i thread si spartiscono la frontiera (il bucket corrente) a blocchi, e rilassano gli archi leggeri
+ * dei vertici che appartengono ancora al bucket, ricordandoli per il passo pesante. Un vertice può comparire più volte
+ * nei bucket (una per ogni miglioramento della sua distanza): viene elaborato solo se la sua distanza è cambiata
+ * dall'ultima volta che i suoi archi sono stati rilassati.
+ */
+static void* gp_lightStep(void* arg) {
+	gp_delta_worker* w = (gp_delta_worker*)arg;
+	gp_delta_state* s = w->state;
+	int begin, end;
+	while (tp_nextChunk(s->pool, FRONTIER_CHUNK, &begin, &end)) {
+		for (int i = begin; i < end; i++) {
+			int u = s->frontier[i];
+			double distance = gp_loadDistance(&s->distances[u]);
+			if ((long)(distance / s->delta) < s->bucket || gp_loadDistance(&s->relaxed_distances[u]) == distance) {
+				continue;
+			}
+			__atomic_store(&s->relaxed_distances[u], &distance, __ATOMIC_RELAXED);
+			gp_pushVertex(&w->removed, &w->removed_size, &w->removed_capacity, u);
+			gp_relaxArcs(w, u, true);
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Passo pesante: ogni thread rilassa gli archi pesanti dei vertici che ha rimosso dal bucket corrente.
+ */
+static void* gp_heavyStep(void* arg) {
+	gp_delta_worker* w = (gp_delta_worker*)arg;
+	for (int i = 0; i < w->removed_size; i++) {
+		gp_relaxArcs(w, w->removed[i], false);
+	}
+	w->removed_size = 0;
+	return NULL;
+}
+
+/**
+ * Raccoglie nella frontiera il contenuto del bucket corrente di tutti i thread, svuotandolo.
+ */
+static void gp_gatherBucket(gp_delta_worker* workers, int threads_number, int** frontier, int* frontier_capacity) {
+	gp_delta_state* s = workers[0].state;
+	long bucket = s->bucket;
+	int size = 0;
+	for (int i = 0; i < threads_number; i++) {
+		if (bucket < workers[i].bins_number) {
+			size += workers[i].bin_sizes[bucket];
+		}
+	}
+	if (size > *frontier_capacity) {
+		*frontier_capacity = size;
+		*frontier = realloc(*frontier, (size_t)size * sizeof(int));
+		if (!*frontier) {
+			MEMORY_ERROR;
+		}
+	}
+	s->frontier = *frontier;
+	s->frontier_size = 0;
+	for (int i = 0; i < threads_number; i++) {
+		if (bucket < workers[i].bins_number && workers[i].bin_sizes[bucket] > 0) {
+			memcpy(s->frontier + s->frontier_size, workers[i].bins[bucket], workers[i].bin_sizes[bucket] * sizeof(int));
+			s->frontier_size += workers[i].bin_sizes[bucket];
+			workers[i].bin_sizes[bucket] = 0;
+		}
+	}
+}
+
+/**
+ * Restituisce l'indice del primo bucket non vuoto successivo al corrente, in qualsiasi thread, oppure -1.
+ * I bucket precedenti, ormai elaborati, vengono liberati.
+ */
+static long gp_findNextBucket(gp_delta_worker* workers, int threads_number) {
+	long current = workers[0].state->bucket;
+	long next = -1;
+	for (int i = 0; i < threads_number; i++) {
+		gp_delta_worker* w = &workers[i];
+		if (current < w->bins_number) {
+			free(w->bins[current]);
+			w->bins[current] = NULL;
+			w->bin_capacities[current] = 0;
+		}
+		for (long bin = current + 1; bin < w->bins_number && (next == -1 || bin < next); bin++) {
+			if (w->bin_sizes[bin] > 0) {
+				next = bin;
+				break;
+			}
+		}
+	}
+	return next;
+}
+
+/**
+ * Ricostruisce i padri a partire dalle distanze definitive, con una visita in ampiezza dalla sorgente sugli archi
+ * "tesi" (quelli da cui la distanza della destinazione si ottiene esattamente, con la stessa somma calcolata durante
+ * il rilassamento). Ogni vertice prende come padre un vertice già nell'albero, quindi i padri non formano cicli
+ * nemmeno in presenza di archi di peso nullo.
+ */
+static void gp_rebuildParents(graph* g, int source, double* distances, int* parents) {
+	for (int v = 0; v < g->vertices_number; v++) {
+		parents[v] = NO_PARENT;
+	}
+	int* queue = malloc((size_t)g->vertices_number * sizeof(int) + 1);
+	if (!queue) {
+		MEMORY_ERROR;
+	}
+	int head = 0;
+	int tail = 0;
+	queue[tail++] = source;
+	while (head < tail) {
+		int u = queue[head++];
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			int v = g->neighbors[arc];
+			if (v != source && parents[v] == NO_PARENT
+					&& distances[u] + (g->weights ? g->weights[arc] : 1.0) == distances[v]) {
+				parents[v] = u;
+				queue[tail++] = v;
+			}
+		}
+	}
+	free(queue);
+}
+
+// Dijkstra
+
+/**
+ * Calcola le distanze minime dalla sorgente a tutti i vertici raggiungibili.
+ * Restituisce il numero di vertici raggiunti (sorgente inclusa).
+ */
+int gp_dijkstra(graph* g, int source, double* distances, int* parents) {
+	return gp_searchOnce(g, &source, 1, NO_TARGET, INFINITY, NULL, NULL, distances, parents);
+}
+
+/**
+ * Calcola, per ogni vertice, la distanza minima dalla sorgente più vicina fra quelle date.
+ * Seguendo l'array "parents" da un vertice si arriva alla sorgente più vicina ad esso.
+ * Restituisce il numero di vertici raggiunti (sorgenti incluse).
+ */
+int gp_multiSourceDijkstra(graph* g, int* sources, int sources_number, double* distances, int* parents) {
+	return gp_searchOnce(g, sources, sources_number, NO_TARGET, INFINITY, NULL, NULL, distances, parents);
+}
+
+/**
+ * Come "gp_multiSourceDijkstra", ma considera solamente i vertici con distanza non superiore al raggio dato:
+ * i vertici più lontani non vengono mai inseriti nell'heap, e rimangono a distanza INFINITY.
+ * Restituisce il numero di vertici raggiunti entro il raggio.
+ */
+int gp_boundedDijkstra(graph* g, int* sources, int sources_number, double radius,
+		double* distances, int* parents) {
+	return gp_searchOnce(g, sources, sources_number, NO_TARGET, radius, NULL, NULL, distances, parents);
+}
+
+// A*
+
+/**
+ * Calcola il cammino minimo dalla sorgente al bersaglio con l'algoritmo A*, restituendone la lunghezza
+ * (INFINITY se il bersaglio non è raggiungibile).
+ * La funzione "heuristic(vertex, target, context)" deve restituire una stima per difetto della distanza fra
+ * il vertice e il bersaglio (ad esempio la distanza in linea d'aria, se i vertici sono punti del piano);
+ * il puntatore "context" le viene passato così com'è. Un'euristica nulla equivale all'algoritmo di Dijkstra
+ * con uscita anticipata.
+ *
+ * <i>NOTA:</i> Al termine, solamente la distanza del bersaglio e i padri lungo il cammino verso di esso sono
+ * garantiti essere minimi; gli altri valori sono provvisori.
+ */
+double gp_aStar(graph* g, int source, int target, double (*heuristic)(int, int, void*), void* context,
+		double* distances, int* parents) {
+	if (target < 0 || target >= g->vertices_number) {
+		INVALID_VERTEX_ERROR("gp_aStar", target);
+		return INFINITY;
+	}
+	gp_searchOnce(g, &source, 1, target, INFINITY, heuristic, context, distances, parents);
+	return distances[target];
+}
+
+// Search Context
+
+/**
+ * Inizializza un contesto di ricerca sul grafo dato, allocando l'heap e gli array dei risultati una volta per tutte.
+ * Dopo ogni ricerca, i campi "distances" e "parents" contengono i risultati (come per le funzioni corrispondenti)
+ * e rimangono validi fino alla ricerca successiva; i vertici raggiunti sono elencati nell'array "touched".
+ */
+gp_search_context* gp_initSearchContext(graph* g) {
+	gp_search_context* c = malloc(sizeof(gp_search_context));
+	if (!c) {
+		MEMORY_ERROR;
+	}
+	int vertices_number = g->vertices_number;
+	c->g = g;
+	c->frontier = ih_initHeap(vertices_number);
+	c->distances = malloc((size_t)vertices_number * sizeof(double) + 1);
+	c->parents = malloc((size_t)vertices_number * sizeof(int) + 1);
+	c->touched = malloc((size_t)vertices_number * sizeof(int) + 1);
+	if (!c->distances || !c->parents || !c->touched) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		c->distances[v] = INFINITY;
+		c->parents[v] = NO_PARENT;
+	}
+	c->touched_size = 0;
+	return c;
+}
+
+/**
+ * Elimina il contesto di ricerca, ripulendo la memoria occupata dall'heap e dagli array. Il grafo non viene eliminato.
+ */
+void gp_deleteSearchContext(gp_search_context* c) {
+	ih_deleteHeap(c->frontier);
+	free(c->distances);
+	free(c->parents);
+	free(c->touched);
+	free(c);
+}
+
+/**
+ * Come "gp_boundedDijkstra" (con raggio INFINITY equivale a "gp_multiSourceDijkstra"), riutilizzando il contesto:
+ * il costo della ricerca è proporzionale ai soli vertici raggiunti e ai loro archi.
+ * Restituisce il numero di vertici raggiunti entro il raggio.
+ */
+int gp_contextDijkstra(gp_search_context* c, int* sources, int sources_number, double radius) {
+	gp_resetSearchContext(c);
+	return gp_search(c->g, c->frontier, sources, sources_number, NO_TARGET, radius, NULL, NULL,
+		c->distances, c->parents, c->touched, &c->touched_size);
+}
+
+/**
+ * Come "gp_aStar", riutilizzando il contesto: il costo della ricerca è proporzionale ai soli vertici toccati.
+ * Restituisce la lunghezza del cammino minimo (INFINITY se il bersaglio non è raggiungibile).
+ */
+double gp_contextAStar(gp_search_context* c, int source, int target, double (*heuristic)(int, int, void*),
+		void* context) {
+	gp_resetSearchContext(c);
+	if (target < 0 || target >= c->g->vertices_number) {
+		INVALID_VERTEX_ERROR("gp_contextAStar", target);
+		return INFINITY;
+	}
+	gp_search(c->g, c->frontier, &source, 1, target, INFINITY, heuristic, context,
+		c->distances, c->parents, c->touched, &c->touched_size);
+	return c->distances[target];
+}
+
+// Delta-Stepping
+
+/**
+ * Calcola le distanze minime dalla sorgente con l'algoritmo delta-stepping (vedi la nota iniziale), utilizzando
+ * il numero di thread dato (se non positivo, uno per processore). Se delta non è positivo, viene scelto come il peso
+ * massimo diviso per il grado medio, come suggerito da Meyer e Sanders. Restituisce il numero di vertici raggiunti.
+ *
+ * Il numero di bucket è pari alla distanza massima divisa per delta: delta non deve essere troppo piccolo rispetto ai
+ * pesi. I padri vengono ricostruiti al termine dalle distanze, e formano un albero di cammini minimi con radice nella
+ * sorgente (anche in presenza di archi di peso nullo).
+ */
+int gp_deltaStepping(graph* g, int source, double delta, int threads_number, double* distances, int* parents) {
+	int vertices_number = g->vertices_number;
+	if (source < 0 || source >= vertices_number) {
+		INVALID_VERTEX_ERROR("gp_deltaStepping", source);
+		return 0;
+	}
+	long arcs_number = g->offsets[vertices_number];
+	if (delta <= 0) {
+		double max_weight = g->weights ? 0 : 1.0;
+		for (long arc = 0; g->weights && arc < arcs_number; arc++) {
+			max_weight = fmax(max_weight, g->weights[arc]);
+		}
+		double average_degree = vertices_number > 0 ? (double)arcs_number / vertices_number : 1;
+		delta = (average_degree > 1 ? max_weight / average_degree : max_weight);
+		if (delta <= 0) {
+			delta = 1.0;
+		}
+	}
+	gp_delta_state s;
+	s.pool = tp_initThreadPool(threads_number);
+	threads_number = s.pool->threads_number;
+	s.g = g;
+	s.delta = delta;
+	s.distances = distances;
+	s.relaxed_distances = malloc((size_t)vertices_number * sizeof(double) + 1);
+	gp_delta_worker* workers = calloc(threads_number, sizeof(gp_delta_worker));
+	if (!s.relaxed_distances || !workers) {
+		MEMORY_ERROR;
+	}
+	for (int i = 0; i < threads_number; i++) {
+		workers[i].state = &s;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		distances[v] = INFINITY;
+		s.relaxed_distances[v] = INFINITY;
+	}
+
+	distances[source] = 0;
+	int* frontier = NULL;
+	int frontier_capacity = 0;
+	s.bucket = 0;
+	gp_pushToBin(&workers[0], 0, source);
+	while (s.bucket >= 0) {
+		gp_gatherBucket(workers, threads_number, &frontier, &frontier_capacity);
+		while (s.frontier_size > 0) {
+			tp_runStep(s.pool, gp_lightStep, workers, sizeof(gp_delta_worker), s.frontier_size);
+			gp_gatherBucket(workers, threads_number, &frontier, &frontier_capacity);
+		}
+		tp_runStep(s.pool, gp_heavyStep, workers, sizeof(gp_delta_worker), 0);
+		s.bucket = gp_findNextBucket(workers, threads_number);
+	}
+
+	int reached = 0;
+	for (int v = 0; v < vertices_number; v++) {
+		if (distances[v] != INFINITY) {
+			reached++;
+		}
+	}
+	if (parents) {
+		gp_rebuildParents(g, source, distances, parents);
+	}
+	for (int i = 0; i < threads_number; i++) {
+		for (long bin = 0; bin < workers[i].bins_number; bin++) {
+			free(workers[i].bins[bin]);
+		}
+		free(workers[i].bins);
+		free(workers[i].bin_sizes);
+		free(workers[i].bin_capacities);
+		free(workers[i].removed);
+	}
+	free(workers);
+	free(frontier);
+	free(s.relaxed_distances);
+	tp_deleteThreadPool(s.pool);
+	return reached;
+}
+
+// Paths
+
+/**
+ * Ricostruisce il cammino che termina nel vertice "target" seguendo l'array "parents", e lo scrive nell'array
+ * "path" (fornito dal chiamante, di lunghezza sufficiente) a partire dalla sorgente.
+ * Restituisce il numero di vertici del cammino. Se "path" è NULL, restituisce solamente la lunghezza.
+ */
+int gp_getPath(int* parents, int target, int* path) {
+	int length = 0;
+	for (int v = target; v != NO_PARENT; v = parents[v]) {
+		length++;
+	}
+	if (path) {
+		int i = length;
+		for (int v = target; v != NO_PARENT; v = parents[v]) {
+			path[--i] = v;
+		}
+	}
+	return length;
+}
@@ -0,0 +1,42 @@
+#ifndef GRAPHPATHS_H_
+#define GRAPHPATHS_H_
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+
+#define NO_PARENT (-1)
+
+typedef struct gp_search_context {
+	graph* g;
+	indexedheap* frontier;
+	double* distances;
+	int* parents;
+	int* touched;
+	int touched_size;
+} gp_search_context;
+
+// Dijkstra
+int gp_dijkstra(graph* g, int source, double* distances, int* parents); // OK
+int gp_multiSourceDijkstra(graph* g, int* sources, int sources_number, double* distances, int* parents); // OK
+int gp_boundedDijkstra(graph* g, int* sources, int sources_number, double radius,
+		double* distances, int* parents); // OK
+
+// A*
+double gp_aStar(graph* g, int source, int target, double (*heuristic)(int, int, void*), void* context,
+		double* distances, int* parents); // OK
+
+// Search Context
+gp_search_context* gp_initSearchContext(graph* g); // OK
+void gp_deleteSearchContext(gp_search_context* c); // OK
+int gp_contextDijkstra(gp_search_context* c, int* sources, int sources_number, double radius); // OK
+double gp_contextAStar(gp_search_context* c, int source, int target, double (*heuristic)(int, int, void*),
+		void* context); // OK
+
+// Delta-Stepping
+int gp_deltaStepping(graph* g, int source, double delta, int threads_number,
+		double* distances, int* parents); // OK
+
+// Paths
+int gp_getPath(int* parents, int target, int* path); // OK
+
+#endif
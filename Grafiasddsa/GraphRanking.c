@@ -0,0 +1,420 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "GraphRanking.h"
+#include "ThreadPool.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+/**
+ * Libreria che implementa il prodotto fra la matrice di adiacenza del grafo CSR e un vettore (SpMV), e l'algoritmo
+ * PageRank basato su di esso.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Nel prodotto y = A x, la riga v della matrice A è la lista dei vicini (uscenti) del vertice v, con i rispettivi pesi
+ * (unitari se il grafo non è pesato): y[v] è quindi la somma pesata di x sui vicini di v. Ogni thread elabora un
+ * intervallo contiguo di righe, scelto in modo che gli intervalli contengano all'incirca lo stesso numero di archi;
+ * ogni elemento di y viene scritto da un solo thread, senza sincronizzazione.
+ *
+ * Il PageRank è calcolato "in pull": ad ogni iterazione, ogni vertice somma i contributi dei suoi predecessori
+ * (il rango di ciascuno diviso per il suo grado uscente), il che equivale al prodotto fra la matrice del grafo
+ * trasposto e il vettore dei contributi. I vertici senza archi uscenti ("dangling") distribuiscono il proprio rango
+ * uniformemente su tutti i vertici. La convergenza viene verificata ad ogni iterazione sulla norma L1 della differenza
+ * fra due vettori di ranghi consecutivi.
+ * Il vettore dei contributi (l'unico acceduto in modo casuale) può essere memorizzato in singola precisione, per
+ * dimezzare il traffico verso la memoria: le somme vengono comunque accumulate in doppia precisione.
+ * Il PageRank può essere calcolato anche sul grafo compresso (cgraph): ogni thread decodifica i predecessori di un
+ * vertice alla volta in un proprio array di lavoro.
+ */
+
+// Static Utility Functions
+
+typedef struct gk_state {
+	graph* g;
+	graph* in;
+	cgraph* compressed_g;
+	cgraph* compressed_in;
+	double* ranks;
+	void* contributions;
+	bool single_precision;
+	double damping;
+	double base_rank;
+} gk_state;
+
+typedef struct gk_worker {
+	gk_state* state;
+	graph* rows;
+	const void* x;
+	void* y;
+	int* buffer;
+	int begin;
+	int end;
+	double dangling_sum;
+	double error;
+} gk_worker;
+
+/**
+ * Restituisce l'inizio della riga di un vertice del grafo CSR, in archi.
+ */
+static long gk_getRowPosition(void* g, int vertex) {
+	return ((graph*)g)->offsets[vertex];
+}
+
+/**
+ * Restituisce l'inizio della riga di un vertice del grafo compresso, in byte.
+ */
+static long gk_getCompressedRowPosition(void* g, int vertex) {
+	return cgr_getRowPosition((cgraph*)g, vertex);
+}
+
+/**
+ * Alloca i lavoratori e suddivide le righe del grafo in intervalli contigui con circa lo stesso numero di archi
+ * (più uno per riga, in modo da bilanciare anche le righe vuote), tramite ricerca binaria sull'inizio delle righe,
+ * restituito dalla funzione "position". Per il grafo compresso l'inizio delle righe è in byte, e gli intervalli
+ * contengono circa lo stesso numero di byte.
+ */
+static gk_worker* gk_initWorkers(void* g, long (*position)(void*, int), int vertices_number, int threads_number,
+		gk_state* state) {
+	gk_worker* workers = malloc(threads_number * sizeof(gk_worker));
+	if (!workers) {
+		MEMORY_ERROR;
+	}
+	double total = (double)position(g, vertices_number) + vertices_number;
+	int begin = 0;
+	for (int i = 0; i < threads_number; i++) {
+		double target = total * (i + 1) / threads_number;
+		int low = begin;
+		int high = vertices_number;
+		while (low < high) {
+			int middle = low + (high - low) / 2;
+			if ((double)position(g, middle) + middle < target) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+		workers[i].state = state;
+		workers[i].rows = NULL;
+		workers[i].buffer = NULL;
+		workers[i].begin = begin;
+		workers[i].end = (i == threads_number - 1) ? vertices_number : low;
+		begin = workers[i].end;
+	}
+	return workers;
+}
+
+/**
+ * Prodotto fra le righe del lavoratore e il vettore x, in doppia precisione.
+ */
+static void* gk_multiplyStep(void* arg) {
+	gk_worker* w = (gk_worker*)arg;
+	long* offsets = w->rows->offsets;
+	int* neighbors = w->rows->neighbors;
+	double* weights = w->rows->weights;
+	const double* x = w->x;
+	double* y = w->y;
+	for (int v = w->begin; v < w->end; v++) {
+		double sum = 0;
+		if (weights) {
+			for (long arc = offsets[v]; arc < offsets[v + 1]; arc++) {
+				sum += weights[arc] * x[neighbors[arc]];
+			}
+		} else {
+			for (long arc = offsets[v]; arc < offsets[v + 1]; arc++) {
+				sum += x[neighbors[arc]];
+			}
+		}
+		y[v] = sum;
+	}
+	return NULL;
+}
+
+/**
+ * Prodotto fra le righe del lavoratore e il vettore x, in singola precisione (con accumulo in doppia precisione).
+ */
+static void* gk_multiplyFloatStep(void* arg) {
+	gk_worker* w = (gk_worker*)arg;
+	long* offsets = w->rows->offsets;
+	int* neighbors = w->rows->neighbors;
+	double* weights = w->rows->weights;
+	const float* x = w->x;
+	float* y = w->y;
+	for (int v = w->begin; v < w->end; v++) {
+		double sum = 0;
+		if (weights) {
+			for (long arc = offsets[v]; arc < offsets[v + 1]; arc++) {
+				sum += weights[arc] * x[neighbors[arc]];
+			}
+		} else {
+			for (long arc = offsets[v]; arc < offsets[v + 1]; arc++) {
+				sum += x[neighbors[arc]];
+			}
+		}
+		y[v] = (float)sum;
+	}
+	return NULL;
+}
+
+/**
+ * Primo passo di un'iterazione di PageRank: calcola i contributi dei vertici del lavoratore (rispetto al grafo
+ * originale) e la somma dei ranghi dei vertici dangling.
+ */
+static void* gk_contributeStep(void* arg) {
+	gk_worker* w = (gk_worker*)arg;
+	gk_state* s = w->state;
+	long* offsets = s->g->offsets;
+	w->dangling_sum = 0;
+	for (int v = w->begin; v < w->end; v++) {
+		long degree = offsets[v + 1] - offsets[v];
+		double contribution = degree > 0 ? s->ranks[v] / degree : 0;
+		if (degree == 0) {
+			w->dangling_sum += s->ranks[v];
+		}
+		if (s->single_precision) {
+			((float*)s->contributions)[v] = (float)contribution;
+		} else {
+			((double*)s->contributions)[v] = contribution;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Secondo passo di un'iterazione di PageRank: ogni vertice del lavoratore raccoglie i contributi dei suoi
+ * predecessori e aggiorna il proprio rango, accumulando la differenza rispetto al rango precedente.
+ */
+static void* gk_pullStep(void* arg) {
+	gk_worker* w = (gk_worker*)arg;
+	gk_state* s = w->state;
+	long* offsets = s->in->offsets;
+	int* predecessors = s->in->neighbors;
+	w->error = 0;
+	for (int v = w->begin; v < w->end; v++) {
+		double sum = 0;
+		if (s->single_precision) {
+			const float* contributions = s->contributions;
+			for (long arc = offsets[v]; arc < offsets[v + 1]; arc++) {
+				sum += contributions[predecessors[arc]];
+			}
+		} else {
+			const double* contributions = s->contributions;
+			for (long arc = offsets[v]; arc < offsets[v + 1]; arc++) {
+				sum += contributions[predecessors[arc]];
+			}
+		}
+		double rank = s->base_rank + s->damping * sum;
+		w->error += fabs(rank - s->ranks[v]);
+		s->ranks[v] = rank;
+	}
+	return NULL;
+}
+
+/**
+ * Primo passo di un'iterazione di PageRank sul grafo compresso, analogo a "gk_contributeStep".
+ */
+static void* gk_compressedContributeStep(void* arg) {
+	gk_worker* w = (gk_worker*)arg;
+	gk_state* s = w->state;
+	double* contributions = s->contributions;
+	w->dangling_sum = 0;
+	for (int v = w->begin; v < w->end; v++) {
+		int degree = cgr_getVertexDegree(s->compressed_g, v);
+		contributions[v] = degree > 0 ? s->ranks[v] / degree : 0;
+		if (degree == 0) {
+			w->dangling_sum += s->ranks[v];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Secondo passo di un'iterazione di PageRank sul grafo compresso: i predecessori di ogni vertice vengono decodificati
+ * nell'array di lavoro del thread.
+ */
+static void* gk_compressedPullStep(void* arg) {
+	gk_worker* w = (gk_worker*)arg;
+	gk_state* s = w->state;
+	const double* contributions = s->contributions;
+	w->error = 0;
+	for (int v = w->begin; v < w->end; v++) {
+		int degree = cgr_getNeighbors(s->compressed_in, v, w->buffer);
+		double sum = 0;
+		for (int i = 0; i < degree; i++) {
+			sum += contributions[w->buffer[i]];
+		}
+		double rank = s->base_rank + s->damping * sum;
+		w->error += fabs(rank - s->ranks[v]);
+		s->ranks[v] = rank;
+	}
+	return NULL;
+}
+
+// Sparse Matrix-Vector Product
+
+/**
+ * Calcola y = A x, dove A è la matrice di adiacenza (pesata) del grafo, utilizzando il numero di thread dato
+ * (se non positivo, uno per processore). I vettori hanno lunghezza pari al numero di vertici e non devono sovrapporsi.
+ */
+void gk_multiply(graph* g, double* x, double* y, int threads_number) {
+	threadpool* pool = tp_initThreadPool(threads_number);
+	threads_number = pool->threads_number;
+	gk_worker* workers = gk_initWorkers(g, gk_getRowPosition, g->vertices_number, threads_number, NULL);
+	for (int i = 0; i < threads_number; i++) {
+		workers[i].rows = g;
+		workers[i].x = x;
+		workers[i].y = y;
+	}
+	tp_runStep(pool, gk_multiplyStep, workers, sizeof(gk_worker), 0);
+	free(workers);
+	tp_deleteThreadPool(pool);
+}
+
+/**
+ * Come "gk_multiply", con vettori in singola precisione.
+ */
+void gk_multiplyFloat(graph* g, float* x, float* y, int threads_number) {
+	threadpool* pool = tp_initThreadPool(threads_number);
+	threads_number = pool->threads_number;
+	gk_worker* workers = gk_initWorkers(g, gk_getRowPosition, g->vertices_number, threads_number, NULL);
+	for (int i = 0; i < threads_number; i++) {
+		workers[i].rows = g;
+		workers[i].x = x;
+		workers[i].y = y;
+	}
+	tp_runStep(pool, gk_multiplyFloatStep, workers, sizeof(gk_worker), 0);
+	free(workers);
+	tp_deleteThreadPool(pool);
+}
+
+// PageRank
+
+/**
+ * Calcola il PageRank dei vertici (vedi la nota iniziale) e lo scrive nell'array "ranks", di lunghezza pari al
+ * numero di vertici; la somma dei ranghi è 1. Il fattore di smorzamento "damping" è la probabilità di seguire un
+ * arco (tipicamente 0.85). Le iterazioni terminano quando la norma L1 della differenza fra due iterazioni consecutive
+ * scende sotto "tolerance", oppure dopo "max_iterations" iterazioni. Restituisce il numero di iterazioni eseguite.
+ * I pesi degli archi vengono ignorati.
+ *
+ * Per un grafo orientato servono i predecessori, ossia il grafo trasposto: può essere fornito dal chiamante
+ * (vedi "gr_transposeGraph"), altrimenti viene calcolato ed eliminato internamente. Se "single_precision" è vero,
+ * i contributi vengono memorizzati in singola precisione: in tal caso la differenza fra due iterazioni non scende
+ * molto sotto la precisione dei float (circa 1e-7 per rango), e "tolerance" va scelta di conseguenza.
+ */
+int gk_pageRank(graph* g, graph* transposed, double damping, double tolerance, int max_iterations,
+		int threads_number, bool single_precision, double* ranks) {
+	int vertices_number = g->vertices_number;
+	if (vertices_number == 0) {
+		return 0;
+	}
+	threadpool* pool = tp_initThreadPool(threads_number);
+	threads_number = pool->threads_number;
+	gk_state s;
+	s.g = g;
+	s.in = !g->directed ? g : (transposed ? transposed : gr_transposeGraph(g));
+	s.ranks = ranks;
+	s.contributions = malloc((size_t)vertices_number * (single_precision ? sizeof(float) : sizeof(double)));
+	s.single_precision = single_precision;
+	s.damping = damping;
+	if (!s.contributions) {
+		MEMORY_ERROR;
+	}
+	// I contributi si calcolano sul grafo originale e si raccolgono su quello trasposto: i thread sono bilanciati
+	// sugli archi entranti, che dominano il costo dell'iterazione
+	gk_worker* workers = gk_initWorkers(s.in, gk_getRowPosition, vertices_number, threads_number, &s);
+	for (int v = 0; v < vertices_number; v++) {
+		ranks[v] = 1.0 / vertices_number;
+	}
+	int iteration = 0;
+	while (iteration < max_iterations) {
+		tp_runStep(pool, gk_contributeStep, workers, sizeof(gk_worker), 0);
+		double dangling_sum = 0;
+		for (int i = 0; i < threads_number; i++) {
+			dangling_sum += workers[i].dangling_sum;
+		}
+		s.base_rank = (1 - damping) / vertices_number + damping * dangling_sum / vertices_number;
+		tp_runStep(pool, gk_pullStep, workers, sizeof(gk_worker), 0);
+		iteration++;
+		double error = 0;
+		for (int i = 0; i < threads_number; i++) {
+			error += workers[i].error;
+		}
+		if (error < tolerance) {
+			break;
+		}
+	}
+	free(workers);
+	tp_deleteThreadPool(pool);
+	free(s.contributions);
+	if (s.in != g && s.in != transposed) {
+		gr_deleteGraph(s.in);
+	}
+	return iteration;
+}
+
+/**
+ * Come "gk_pageRank", sul grafo compresso (con contributi in doppia precisione). Per un grafo orientato il grafo
+ * compresso trasposto è obbligatorio (può essere ottenuto comprimendo il risultato di "gr_transposeGraph"):
+ * se manca, viene stampato un errore e restituito 0.
+ */
+int gk_compressedPageRank(cgraph* g, cgraph* transposed, double damping, double tolerance, int max_iterations,
+		int threads_number, double* ranks) {
+	int vertices_number = g->vertices_number;
+	if (vertices_number == 0) {
+		return 0;
+	}
+	if (g->directed && !transposed) {
+		printf("Error: Missing transposed graph in \"gk_compressedPageRank\" function.\n");
+		return 0;
+	}
+	threadpool* pool = tp_initThreadPool(threads_number);
+	threads_number = pool->threads_number;
+	gk_state s;
+	s.compressed_g = g;
+	s.compressed_in = g->directed ? transposed : g;
+	s.ranks = ranks;
+	s.contributions = malloc((size_t)vertices_number * sizeof(double));
+	s.damping = damping;
+	if (!s.contributions) {
+		MEMORY_ERROR;
+	}
+	gk_worker* workers = gk_initWorkers(s.compressed_in, gk_getCompressedRowPosition, vertices_number,
+		threads_number, &s);
+	for (int i = 0; i < threads_number; i++) {
+		workers[i].buffer = malloc((size_t)s.compressed_in->max_degree * sizeof(int) + 1);
+		if (!workers[i].buffer) {
+			MEMORY_ERROR;
+		}
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		ranks[v] = 1.0 / vertices_number;
+	}
+	int iteration = 0;
+	while (iteration < max_iterations) {
+		tp_runStep(pool, gk_compressedContributeStep, workers, sizeof(gk_worker), 0);
+		double dangling_sum = 0;
+		for (int i = 0; i < threads_number; i++) {
+			dangling_sum += workers[i].dangling_sum;
+		}
+		s.base_rank = (1 - damping) / vertices_number + damping * dangling_sum / vertices_number;
+		tp_runStep(pool, gk_compressedPullStep, workers, sizeof(gk_worker), 0);
+		iteration++;
+		double error = 0;
+		for (int i = 0; i < threads_number; i++) {
+			error += workers[i].error;
+		}
+		if (error < tolerance) {
+			break;
+		}
+	}
+	for (int i = 0; i < threads_number; i++) {
+		free(workers[i].buffer);
+	}
+	free(workers);
+	tp_deleteThreadPool(pool);
+	free(s.contributions);
+	return iteration;
+}
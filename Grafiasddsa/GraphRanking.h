@@ -0,0 +1,16 @@
+#ifndef GRAPHRANKING_H_
+#define GRAPHRANKING_H_
+
+#include "Graph.h"
+
+// Sparse Matrix-Vector Product
+void gk_multiply(graph* g, double* x, double* y, int threads_number); // OK
+void gk_multiplyFloat(graph* g, float* x, float* y, int threads_number); // OK
+
+// PageRank
+int gk_pageRank(graph* g, graph* transposed, double damping, double tolerance, int max_iterations,
+		int threads_number, bool single_precision, double* ranks); // OK
+int gk_compressedPageRank(cgraph* g, cgraph* transposed, double damping, double tolerance, int max_iterations,
+		int threads_number, double* ranks); // OK
+
+#endif
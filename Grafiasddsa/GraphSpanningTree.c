@@ -0,0 +1,386 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "GraphSpanningTree.h"
+#include "IndexedHeap.h"
+#include "ThreadPool.h"
+#include "UnionFind.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+#define VERTICES_CHUNK 1024
+#define NO_ARC (-1L)
+#define NO_PARENT (-1)
+
+/**
+ * Libreria che implementa gli algoritmi per l'albero ricoprente minimo (MST) del grafo CSR non orientato.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Tutte le funzioni calcolano una foresta ricoprente minima (un albero per ogni componente connessa) e scrivono gli
+ * archi dell'albero negli array "tree_sources", "tree_destinations" e "tree_weights" forniti dal chiamante, di
+ * lunghezza almeno pari al numero di vertici meno uno; l'array dei pesi e il puntatore al peso totale sono opzionali
+ * (possono essere NULL). Viene restituito il numero di archi dell'albero, oppure -1 se il grafo è orientato.
+ * Le funzioni non effettuano allocazioni per arco: la memoria ausiliaria è allocata in blocco all'inizio.
+ * Se il grafo non è pesato, ogni arco ha peso unitario. I cappi vengono ignorati.
+ *
+ * - Kruskal: gli archi vengono ordinati per peso con un radix sort (LSD, a passate di RADIX_BITS bit) sulla
+ *   rappresentazione binaria dei pesi, resa monotona (vedi "gs_getWeightKey"), e aggiunti all'albero in ordine se
+ *   collegano due componenti diverse dell'union-find. Le passate in cui tutte le chiavi hanno la stessa cifra
+ *   vengono saltate.
+ * - Prim: l'albero cresce da un vertice, aggiungendo ogni volta l'arco più leggero uscente dall'albero; i vertici
+ *   esterni sono in un indexedheap con chiave pari al peso (cambiato di segno) del loro arco più leggero verso
+ *   l'albero, che viene promossa quando si trova un arco migliore.
+ * - Boruvka parallelo: a ogni turno, ogni componente sceglie il suo arco uscente più leggero (con un compare-and-swap
+ *   sull'arco migliore della radice), e tutti gli archi scelti vengono aggiunti con le operazioni concorrenti
+ *   dell'union-find. Il numero di componenti almeno si dimezza ad ogni turno. Gli archi di pari peso vengono
+ *   ordinati secondo i loro estremi, in modo che le scelte siano coerenti e non formino cicli.
+ */
+
+// Static Utility Functions
+
+typedef struct gs_sorted_edge {
+	uint64_t key;
+	int source;
+	int destination;
+} gs_sorted_edge;
+
+typedef struct gs_boruvka_state {
+	graph* g;
+	unionfind* uf;
+	long* best_arcs;
+	int* tree_sources;
+	int* tree_destinations;
+	double* tree_weights;
+	int edges_found;
+	threadpool* pool;
+} gs_boruvka_state;
+
+/**
+ * Restituisce true se il grafo è orientato, stampando un errore.
+ */
+static bool gs_checkDirected(graph* g, const char* instr) {
+	if (g->directed) {
+		printf("Error: Cannot execute \"%s\" function on directed graph.\n", instr);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Restituisce il peso di un arco (unitario se il grafo non è pesato).
+ */
+static double gs_getWeight(graph* g, long arc) {
+	return g->weights ? g->weights[arc] : 1.0;
+}
+
+/**
+ * Trasforma un peso in una chiave intera con lo stesso ordinamento: per i valori positivi basta impostare il bit di
+ * segno, per quelli negativi bisogna invertire tutti i bit.
+ */
+static uint64_t gs_getWeightKey(double weight) {
+	uint64_t bits;
+	memcpy(&bits, &weight, sizeof(uint64_t));
+	return (bits & ((uint64_t)1 << 63)) ? ~bits : bits | ((uint64_t)1 << 63);
+}
+
+/**
+ * Inverte la trasformazione di "gs_getWeightKey".
+ */
+static double gs_getKeyWeight(uint64_t key) {
+	uint64_t bits = (key & ((uint64_t)1 << 63)) ? key & ~((uint64_t)1 << 63) : ~key;
+	double weight;
+	memcpy(&weight, &bits, sizeof(uint64_t));
+	return weight;
+}
+
+/**
+ * Ordina gli archi per chiave crescente con un radix sort LSD stabile, usando "buffer" come spazio di lavoro.
+ * Restituisce l'array (fra i due) che contiene il risultato.
+ */
+static gs_sorted_edge* gs_radixSort(gs_sorted_edge* edges, gs_sorted_edge* buffer, long edges_number) {
+	long counts[RADIX_BUCKETS];
+	for (int pass = 0; pass < RADIX_PASSES; pass++) {
+		int shift = pass * RADIX_BITS;
+		memset(counts, 0, sizeof(counts));
+		for (long i = 0; i < edges_number; i++) {
+			counts[(edges[i].key >> shift) & (RADIX_BUCKETS - 1)]++;
+		}
+		if (edges_number == 0 || counts[(edges[0].key >> shift) & (RADIX_BUCKETS - 1)] == edges_number) {
+			continue;
+		}
+		long position = 0;
+		for (int digit = 0; digit < RADIX_BUCKETS; digit++) {
+			long count = counts[digit];
+			counts[digit] = position;
+			position += count;
+		}
+		for (long i = 0; i < edges_number; i++) {
+			buffer[counts[(edges[i].key >> shift) & (RADIX_BUCKETS - 1)]++] = edges[i];
+		}
+		gs_sorted_edge* swap = edges;
+		edges = buffer;
+		buffer = swap;
+	}
+	return edges;
+}
+
+/**
+ * Scrive un arco dell'albero nella posizione data degli array di output.
+ */
+static void gs_writeTreeEdge(int* tree_sources, int* tree_destinations, double* tree_weights, int position,
+		int source, int destination, double weight) {
+	tree_sources[position] = source;
+	tree_destinations[position] = destination;
+	if (tree_weights) {
+		tree_weights[position] = weight;
+	}
+}
+
+/**
+ * Restituisce il vertice da cui esce l'arco dato, con una ricerca binaria sugli offset.
+ */
+static int gs_getArcSource(graph* g, long arc) {
+	int low = 0;
+	int high = g->vertices_number - 1;
+	while (low < high) {
+		int middle = low + (high - low + 1) / 2;
+		if (g->offsets[middle] <= arc) {
+			low = middle;
+		} else {
+			high = middle - 1;
+		}
+	}
+	return low;
+}
+
+/**
+ * Restituisce true se l'arco (source, arc) precede l'arco "other" nell'ordine totale usato da Boruvka:
+ * per peso, poi per estremo minore, poi per estremo maggiore.
+ */
+static bool gs_isLighterArc(graph* g, int source, long arc, long other) {
+	double weight = gs_getWeight(g, arc);
+	double other_weight = gs_getWeight(g, other);
+	if (weight != other_weight) {
+		return weight < other_weight;
+	}
+	int other_source = gs_getArcSource(g, other);
+	int low = source < g->neighbors[arc] ? source : g->neighbors[arc];
+	int other_low = other_source < g->neighbors[other] ? other_source : g->neighbors[other];
+	if (low != other_low) {
+		return low < other_low;
+	}
+	return source + g->neighbors[arc] - low < other_source + g->neighbors[other] - other_low;
+}
+
+/**
+ * Primo passo di un turno di Boruvka: ogni arco fra due componenti diverse viene proposto come arco migliore della
+ * componente del suo vertice di partenza.
+ */
+static void* gs_findLightestStep(void* arg) {
+	gs_boruvka_state* s = (gs_boruvka_state*)arg;
+	graph* g = s->g;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int u = begin; u < end; u++) {
+			int root = uf_concurrentFindSet(s->uf, u);
+			for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+				if (uf_concurrentFindSet(s->uf, g->neighbors[arc]) == root) {
+					continue;
+				}
+				long best = __atomic_load_n(&s->best_arcs[root], __ATOMIC_RELAXED);
+				while ((best == NO_ARC || gs_isLighterArc(g, u, arc, best))
+						&& !__atomic_compare_exchange_n(&s->best_arcs[root], &best, arc,
+							false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				}
+			}
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Secondo passo di un turno di Boruvka: gli archi scelti dalle componenti vengono aggiunti all'albero. Se due
+ * componenti si scelgono a vicenda, solo la prima unione riesce, e l'arco viene scritto una volta sola.
+ */
+static void* gs_mergeStep(void* arg) {
+	gs_boruvka_state* s = (gs_boruvka_state*)arg;
+	graph* g = s->g;
+	int begin, end;
+	while (tp_nextChunk(s->pool, VERTICES_CHUNK, &begin, &end)) {
+		for (int root = begin; root < end; root++) {
+			long arc = s->best_arcs[root];
+			if (arc == NO_ARC) {
+				continue;
+			}
+			s->best_arcs[root] = NO_ARC;
+			int source = gs_getArcSource(g, arc);
+			if (uf_concurrentUnionSets(s->uf, source, g->neighbors[arc])) {
+				int position = __atomic_fetch_add(&s->edges_found, 1, __ATOMIC_RELAXED);
+				gs_writeTreeEdge(s->tree_sources, s->tree_destinations, s->tree_weights, position,
+					source, g->neighbors[arc], gs_getWeight(g, arc));
+			}
+		}
+	}
+	return NULL;
+}
+
+// Minimum Spanning Tree
+
+/**
+ * Calcola la foresta ricoprente minima con l'algoritmo di Kruskal (vedi la nota iniziale).
+ */
+int gs_kruskal(graph* g, int* tree_sources, int* tree_destinations, double* tree_weights, double* total_weight) {
+	if (gs_checkDirected(g, "gs_kruskal")) {
+		return -1;
+	}
+	int vertices_number = g->vertices_number;
+	long arcs_number = g->offsets[vertices_number];
+	// Ogni arco non orientato è memorizzato in entrambe le direzioni: viene considerato una volta sola
+	gs_sorted_edge* edges = malloc((size_t)arcs_number / 2 * sizeof(gs_sorted_edge) + sizeof(gs_sorted_edge));
+	gs_sorted_edge* buffer = malloc((size_t)arcs_number / 2 * sizeof(gs_sorted_edge) + sizeof(gs_sorted_edge));
+	if (!edges || !buffer) {
+		MEMORY_ERROR;
+	}
+	long edges_number = 0;
+	for (int u = 0; u < vertices_number; u++) {
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			if (g->neighbors[arc] > u) {
+				edges[edges_number].key = gs_getWeightKey(gs_getWeight(g, arc));
+				edges[edges_number].source = u;
+				edges[edges_number].destination = g->neighbors[arc];
+				edges_number++;
+			}
+		}
+	}
+	gs_sorted_edge* sorted = gs_radixSort(edges, buffer, edges_number);
+	unionfind* uf = uf_initUnionFind(vertices_number);
+	int tree_size = 0;
+	double total = 0;
+	for (long i = 0; i < edges_number && tree_size < vertices_number - 1; i++) {
+		if (uf_unionSets(uf, sorted[i].source, sorted[i].destination)) {
+			double weight = gs_getKeyWeight(sorted[i].key);
+			gs_writeTreeEdge(tree_sources, tree_destinations, tree_weights, tree_size++,
+				sorted[i].source, sorted[i].destination, weight);
+			total += weight;
+		}
+	}
+	uf_deleteUnionFind(uf);
+	free(edges);
+	free(buffer);
+	if (total_weight) {
+		*total_weight = total;
+	}
+	return tree_size;
+}
+
+/**
+ * Calcola la foresta ricoprente minima con l'algoritmo di Prim (vedi la nota iniziale), facendo crescere un albero
+ * a partire da ogni vertice non ancora raggiunto.
+ */
+int gs_prim(graph* g, int* tree_sources, int* tree_destinations, double* tree_weights, double* total_weight) {
+	if (gs_checkDirected(g, "gs_prim")) {
+		return -1;
+	}
+	int vertices_number = g->vertices_number;
+	int* parents = malloc((size_t)vertices_number * sizeof(int) + 1);
+	bool* in_tree = calloc((size_t)vertices_number + 1, sizeof(bool));
+	if (!parents || !in_tree) {
+		MEMORY_ERROR;
+	}
+	indexedheap* frontier = ih_initHeap(vertices_number);
+	int tree_size = 0;
+	double total = 0;
+	for (int start = 0; start < vertices_number; start++) {
+		if (in_tree[start]) {
+			continue;
+		}
+		parents[start] = NO_PARENT;
+		ih_insertItem(frontier, start, 0);
+		while (ih_getHeapSize(frontier) > 0) {
+			double key;
+			int u = ih_extractRootItem(frontier, &key);
+			in_tree[u] = true;
+			if (parents[u] != NO_PARENT) {
+				gs_writeTreeEdge(tree_sources, tree_destinations, tree_weights, tree_size++, parents[u], u, -key);
+				total -= key;
+			}
+			for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+				int v = g->neighbors[arc];
+				if (in_tree[v]) {
+					continue;
+				}
+				double weight = gs_getWeight(g, arc);
+				if (!ih_containsItem(frontier, v)) {
+					ih_insertItem(frontier, v, -weight);
+					parents[v] = u;
+				} else if (-weight > ih_getItemKey(frontier, v)) {
+					ih_promoteItem(frontier, v, -weight);
+					parents[v] = u;
+				}
+			}
+		}
+	}
+	ih_deleteHeap(frontier);
+	free(parents);
+	free(in_tree);
+	if (total_weight) {
+		*total_weight = total;
+	}
+	return tree_size;
+}
+
+/**
+ * Calcola la foresta ricoprente minima con l'algoritmo di Boruvka, utilizzando il numero di thread dato
+ * (se non positivo, uno per processore). Gli archi vengono restituiti nell'ordine in cui sono stati aggiunti,
+ * che dipende dall'esecuzione dei thread; la foresta è comunque minima.
+ */
+int gs_parallelBoruvka(graph* g, int threads_number, int* tree_sources, int* tree_destinations,
+		double* tree_weights, double* total_weight) {
+	if (gs_checkDirected(g, "gs_parallelBoruvka")) {
+		return -1;
+	}
+	gs_boruvka_state s;
+	s.pool = tp_initThreadPool(threads_number);
+	s.g = g;
+	s.uf = uf_initUnionFind(g->vertices_number);
+	s.best_arcs = malloc((size_t)g->vertices_number * sizeof(long) + 1);
+	s.tree_sources = tree_sources;
+	s.tree_destinations = tree_destinations;
+	// I pesi servono per il peso totale: se non richiesti dal chiamante vengono scritti in un array temporaneo
+	s.tree_weights = (tree_weights || !total_weight) ? tree_weights
+		: malloc((size_t)g->vertices_number * sizeof(double) + 1);
+	s.edges_found = 0;
+	if (!s.best_arcs || (total_weight && !s.tree_weights)) {
+		MEMORY_ERROR;
+	}
+	for (int v = 0; v < g->vertices_number; v++) {
+		s.best_arcs[v] = NO_ARC;
+	}
+	int previous_found;
+	do {
+		previous_found = s.edges_found;
+		tp_runStep(s.pool, gs_findLightestStep, &s, 0, g->vertices_number);
+		tp_runStep(s.pool, gs_mergeStep, &s, 0, g->vertices_number);
+	} while (s.edges_found > previous_found);
+	if (total_weight) {
+		*total_weight = 0;
+		for (int i = 0; i < s.edges_found; i++) {
+			*total_weight += s.tree_weights[i];
+		}
+	}
+	if (s.tree_weights != tree_weights) {
+		free(s.tree_weights);
+	}
+	uf_deleteUnionFind(s.uf);
+	free(s.best_arcs);
+	tp_deleteThreadPool(s.pool);
+	return s.edges_found;
+}
@@ -0,0 +1,14 @@
+#ifndef GRAPHSPANNINGTREE_H_
+#define GRAPHSPANNINGTREE_H_
+
+#include "Graph.h"
+
+// Minimum Spanning Tree
+int gs_kruskal(graph* g, int* tree_sources, int* tree_destinations, double* tree_weights,
+		double* total_weight); // OK
+int gs_prim(graph* g, int* tree_sources, int* tree_destinations, double* tree_weights,
+		double* total_weight); // OK
+int gs_parallelBoruvka(graph* g, int threads_number, int* tree_sources, int* tree_destinations,
+		double* tree_weights, double* total_weight); // OK
+
+#endif
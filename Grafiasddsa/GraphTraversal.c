@@ -0,0 +1,463 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "GraphTraversal.h"
+#include "ThreadPool.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef INVALID_VERTEX_ERROR
+#	define INVALID_VERTEX_ERROR(instr, vertex) printf("Error: Invalid vertex %d in \"%s\" function.\n", vertex, instr )
+#endif
+
+#define BITMAP_WORD_BITS 64
+#define TOP_DOWN_CHUNK 64
+#define BOTTOM_UP_CHUNK 16
+#define BOTTOM_UP_EDGES_FACTOR 14
+#define TOP_DOWN_VERTICES_FACTOR 24
+#define INITIAL_BUFFER_CAPACITY 1024
+
+/**
+ * Libreria che implementa le visite in ampiezza (BFS) sul grafo CSR.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Entrambe le funzioni scrivono negli array forniti dal chiamante la distanza (in numero di archi) di ogni vertice
+ * dalla sorgente e il suo padre nell'albero di visita; i vertici non raggiunti hanno distanza UNREACHED_DISTANCE e
+ * padre NO_PARENT. L'array "parents" è opzionale per la visita sequenziale, obbligatorio per quella parallela.
+ *
+ * La visita parallela è "direction-optimizing" (Beamer et al.): ogni livello può essere espanso in due modi.
+ * - Top-down: ogni vertice della frontiera (memorizzata come coda) visita i propri vicini, e li reclama con un'operazione
+ *   atomica. È conveniente quando la frontiera è piccola.
+ * - Bottom-up: ogni vertice non ancora raggiunto cerca, fra i propri predecessori, un vertice della frontiera
+ *   (memorizzata come bitmap), fermandosi al primo trovato. È conveniente quando la frontiera è grande, come accade
+ *   nei livelli centrali dei grafi con distribuzione dei gradi a legge di potenza.
+ * Si passa al bottom-up quando gli archi uscenti dalla frontiera superano 1/BOTTOM_UP_EDGES_FACTOR degli archi non
+ * ancora esplorati, e si torna al top-down quando la frontiera, ormai in diminuzione, scende sotto
+ * 1/TOP_DOWN_VERTICES_FACTOR dei vertici. Ogni livello viene suddiviso fra i thread in blocchi assegnati dinamicamente.
+ *
+ * Gli ordinamenti topologici scrivono i vertici nell'array "order" fornito dal chiamante. Entrambi sono iterativi
+ * (la profondità della visita non è limitata dallo stack del programma) e usano come memoria ausiliaria un solo array
+ * per vertice, oltre all'array di output stesso, che viene riutilizzato come coda o come pila.
+ */
+
+// Static Utility Functions
+
+typedef struct gt_bfs_state {
+	graph* g;
+	graph* in;
+	int* distances;
+	int* parents;
+	int next_distance;
+	int threads_number;
+	int* frontier;
+	int frontier_size;
+	uint64_t* current_bitmap;
+	uint64_t* next_bitmap;
+	int words_number;
+	threadpool* pool;
+} gt_bfs_state;
+
+typedef struct gt_bfs_worker {
+	gt_bfs_state* state;
+	int* buffer;
+	int buffer_size;
+	int buffer_capacity;
+	int found;
+	long found_edges;
+} gt_bfs_worker;
+
+/**
+ * Restituisce il grado uscente di un vertice, senza controlli.
+ */
+static long gt_getDegree(graph* g, int vertex) {
+	return g->offsets[vertex + 1] - g->offsets[vertex];
+}
+
+/**
+ * Aggiunge un vertice al buffer locale di un thread.
+ */
+static void gt_pushToBuffer(gt_bfs_worker* w, int vertex) {
+	if (w->buffer_size == w->buffer_capacity) {
+		w->buffer_capacity *= 2;
+		w->buffer = realloc(w->buffer, w->buffer_capacity * sizeof(int));
+		if (!w->buffer) {
+			MEMORY_ERROR;
+		}
+	}
+	w->buffer[w->buffer_size++] = vertex;
+}
+
+/**
+ * Passo top-down: i thread si spartiscono la frontiera a blocchi di TOP_DOWN_CHUNK vertici, e ogni vertice scoperto
+ * viene reclamato impostandone atomicamente la distanza. I vertici scoperti finiscono nel buffer locale del thread.
+ */
+static void* gt_topDownStep(void* arg) {
+	gt_bfs_worker* w = (gt_bfs_worker*)arg;
+	gt_bfs_state* s = w->state;
+	long* offsets = s->g->offsets;
+	int* neighbors = s->g->neighbors;
+	w->buffer_size = 0;
+	w->found_edges = 0;
+	int begin, end;
+	while (tp_nextChunk(s->pool, TOP_DOWN_CHUNK, &begin, &end)) {
+		for (int i = begin; i < end; i++) {
+			int u = s->frontier[i];
+			for (long arc = offsets[u]; arc < offsets[u + 1]; arc++) {
+				int v = neighbors[arc];
+				int expected = UNREACHED_DISTANCE;
+				if (__atomic_load_n(&s->distances[v], __ATOMIC_RELAXED) == UNREACHED_DISTANCE
+						&& __atomic_compare_exchange_n(&s->distances[v], &expected, s->next_distance,
+							false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+					s->parents[v] = u;
+					gt_pushToBuffer(w, v);
+					w->found_edges += gt_getDegree(s->g, v);
+				}
+			}
+		}
+	}
+	w->found = w->buffer_size;
+	return NULL;
+}
+
+/**
+ * Passo bottom-up: i thread si spartiscono i vertici a blocchi di BOTTOM_UP_CHUNK parole della bitmap, in modo che
+ * ogni parola della nuova bitmap venga scritta da un solo thread (e senza operazioni atomiche).
+ */
+static void* gt_bottomUpStep(void* arg) {
+	gt_bfs_worker* w = (gt_bfs_worker*)arg;
+	gt_bfs_state* s = w->state;
+	long* offsets = s->in->offsets;
+	int* predecessors = s->in->neighbors;
+	int vertices_number = s->g->vertices_number;
+	w->found = 0;
+	w->found_edges = 0;
+	int begin, end;
+	while (tp_nextChunk(s->pool, BOTTOM_UP_CHUNK, &begin, &end)) {
+		for (int word = begin; word < end; word++) {
+			uint64_t next_word = 0;
+			for (int bit = 0; bit < BITMAP_WORD_BITS; bit++) {
+				int v = word * BITMAP_WORD_BITS + bit;
+				if (v >= vertices_number) {
+					break;
+				}
+				if (s->distances[v] != UNREACHED_DISTANCE) {
+					continue;
+				}
+				for (long arc = offsets[v]; arc < offsets[v + 1]; arc++) {
+					int u = predecessors[arc];
+					if ((s->current_bitmap[u / BITMAP_WORD_BITS] >> (u % BITMAP_WORD_BITS)) & 1) {
+						s->distances[v] = s->next_distance;
+						s->parents[v] = u;
+						next_word |= (uint64_t)1 << bit;
+						w->found++;
+						w->found_edges += gt_getDegree(s->g, v);
+						break;
+					}
+				}
+			}
+			s->next_bitmap[word] = next_word;
+		}
+	}
+	return NULL;
+}
+
+// Breadth-First Search
+
+/**
+ * Visita in ampiezza sequenziale, con una coda implementata come array.
+ * Restituisce il numero di vertici raggiunti (sorgente inclusa).
+ */
+int gt_breadthFirstSearch(graph* g, int source, int* distances, int* parents) {
+	int vertices_number = g->vertices_number;
+	if (source < 0 || source >= vertices_number) {
+		INVALID_VERTEX_ERROR("gt_breadthFirstSearch", source);
+		return 0;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		distances[v] = UNREACHED_DISTANCE;
+	}
+	if (parents) {
+		for (int v = 0; v < vertices_number; v++) {
+			parents[v] = NO_PARENT;
+		}
+	}
+	int* queue = malloc((size_t)vertices_number * sizeof(int));
+	if (!queue) {
+		MEMORY_ERROR;
+	}
+	int head = 0;
+	int tail = 0;
+	distances[source] = 0;
+	queue[tail++] = source;
+	while (head < tail) {
+		int u = queue[head++];
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			int v = g->neighbors[arc];
+			if (distances[v] == UNREACHED_DISTANCE) {
+				distances[v] = distances[u] + 1;
+				if (parents) {
+					parents[v] = u;
+				}
+				queue[tail++] = v;
+			}
+		}
+	}
+	free(queue);
+	return tail;
+}
+
+/**
+ * Visita in ampiezza sequenziale sul grafo compresso: come "gt_breadthFirstSearch", ma i vicini di ogni vertice
+ * estratto dalla coda vengono decodificati in blocco in un array di lavoro (lungo quanto il grado massimo).
+ */
+int gt_compressedBreadthFirstSearch(cgraph* g, int source, int* distances, int* parents) {
+	int vertices_number = g->vertices_number;
+	if (source < 0 || source >= vertices_number) {
+		INVALID_VERTEX_ERROR("gt_compressedBreadthFirstSearch", source);
+		return 0;
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		distances[v] = UNREACHED_DISTANCE;
+	}
+	if (parents) {
+		for (int v = 0; v < vertices_number; v++) {
+			parents[v] = NO_PARENT;
+		}
+	}
+	int* queue = malloc((size_t)vertices_number * sizeof(int));
+	int* neighbors = malloc((size_t)g->max_degree * sizeof(int) + 1);
+	if (!queue || !neighbors) {
+		MEMORY_ERROR;
+	}
+	int head = 0;
+	int tail = 0;
+	distances[source] = 0;
+	queue[tail++] = source;
+	while (head < tail) {
+		int u = queue[head++];
+		int degree = cgr_getNeighbors(g, u, neighbors);
+		for (int i = 0; i < degree; i++) {
+			int v = neighbors[i];
+			if (distances[v] == UNREACHED_DISTANCE) {
+				distances[v] = distances[u] + 1;
+				if (parents) {
+					parents[v] = u;
+				}
+				queue[tail++] = v;
+			}
+		}
+	}
+	free(queue);
+	free(neighbors);
+	return tail;
+}
+
+/**
+ * Visita in ampiezza parallela "direction-optimizing" (vedi la nota iniziale), eseguita con il numero di thread
+ * indicato (se non positivo, uno per ogni processore disponibile). Restituisce il numero di vertici raggiunti.
+ *
+ * Il passo bottom-up richiede i predecessori di ogni vertice, ossia il grafo trasposto: per un grafo orientato può
+ * essere fornito dal chiamante (vedi "gr_transposeGraph"), in modo da riutilizzarlo fra più visite; se NULL, viene
+ * calcolato ed eliminato internamente. Per un grafo non orientato il parametro viene ignorato.
+ *
+ * <i>NOTA:</i> Le distanze sono sempre minime; se un vertice ha più padri possibili allo stesso livello, quello
+ * scelto dipende dall'ordine di esecuzione dei thread.
+ */
+int gt_parallelBreadthFirstSearch(graph* g, graph* transposed, int source, int threads_number,
+		int* distances, int* parents) {
+	int vertices_number = g->vertices_number;
+	if (source < 0 || source >= vertices_number) {
+		INVALID_VERTEX_ERROR("gt_parallelBreadthFirstSearch", source);
+		return 0;
+	}
+	gt_bfs_state s;
+	s.pool = tp_initThreadPool(threads_number);
+	threads_number = s.pool->threads_number;
+	s.g = g;
+	s.in = !g->directed ? g : (transposed ? transposed : gr_transposeGraph(g));
+	s.distances = distances;
+	s.parents = parents;
+	s.threads_number = threads_number;
+	s.words_number = (vertices_number + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS;
+	s.frontier = malloc(((size_t)vertices_number + 1) * sizeof(int));
+	s.current_bitmap = calloc((size_t)s.words_number + 1, sizeof(uint64_t));
+	s.next_bitmap = calloc((size_t)s.words_number + 1, sizeof(uint64_t));
+	gt_bfs_worker* workers = malloc(threads_number * sizeof(gt_bfs_worker));
+	if (!s.frontier || !s.current_bitmap || !s.next_bitmap || !workers) {
+		MEMORY_ERROR;
+	}
+	for (int i = 0; i < threads_number; i++) {
+		workers[i].state = &s;
+		workers[i].buffer_capacity = INITIAL_BUFFER_CAPACITY;
+		workers[i].buffer = malloc(INITIAL_BUFFER_CAPACITY * sizeof(int));
+		if (!workers[i].buffer) {
+			MEMORY_ERROR;
+		}
+	}
+	for (int v = 0; v < vertices_number; v++) {
+		distances[v] = UNREACHED_DISTANCE;
+		parents[v] = NO_PARENT;
+	}
+
+	distances[source] = 0;
+	s.frontier[0] = source;
+	s.frontier_size = 1;
+	s.next_distance = 1;
+	long frontier_edges = gt_getDegree(g, source);
+	long unexplored_edges = g->offsets[vertices_number] - frontier_edges;
+	int reached = 1;
+	bool bottom_up = false;
+	while (s.frontier_size > 0) {
+		int previous_size = s.frontier_size;
+		if (!bottom_up && frontier_edges > unexplored_edges / BOTTOM_UP_EDGES_FACTOR) {
+			// Passaggio al bottom-up: la frontiera viene convertita in bitmap
+			memset(s.current_bitmap, 0, (size_t)s.words_number * sizeof(uint64_t));
+			for (int i = 0; i < s.frontier_size; i++) {
+				int v = s.frontier[i];
+				s.current_bitmap[v / BITMAP_WORD_BITS] |= (uint64_t)1 << (v % BITMAP_WORD_BITS);
+			}
+			bottom_up = true;
+		}
+		int found = 0;
+		long found_edges = 0;
+		if (bottom_up) {
+			tp_runStep(s.pool, gt_bottomUpStep, workers, sizeof(gt_bfs_worker), s.words_number);
+			uint64_t* aux = s.current_bitmap;
+			s.current_bitmap = s.next_bitmap;
+			s.next_bitmap = aux;
+			for (int i = 0; i < threads_number; i++) {
+				found += workers[i].found;
+				found_edges += workers[i].found_edges;
+			}
+			s.frontier_size = found;
+			if (found < previous_size && found < vertices_number / TOP_DOWN_VERTICES_FACTOR) {
+				// Ritorno al top-down: la frontiera viene convertita in coda
+				int size = 0;
+				for (int word = 0; word < s.words_number; word++) {
+					uint64_t bits = s.current_bitmap[word];
+					while (bits) {
+						s.frontier[size++] = word * BITMAP_WORD_BITS + __builtin_ctzll(bits);
+						bits &= bits - 1;
+					}
+				}
+				bottom_up = false;
+			}
+		} else {
+			tp_runStep(s.pool, gt_topDownStep, workers, sizeof(gt_bfs_worker), s.frontier_size);
+			for (int i = 0; i < threads_number; i++) {
+				memcpy(s.frontier + found, workers[i].buffer, workers[i].buffer_size * sizeof(int));
+				found += workers[i].found;
+				found_edges += workers[i].found_edges;
+			}
+			s.frontier_size = found;
+		}
+		reached += found;
+		frontier_edges = found_edges;
+		unexplored_edges -= found_edges;
+		s.next_distance++;
+	}
+
+	for (int i = 0; i < threads_number; i++) {
+		free(workers[i].buffer);
+	}
+	free(workers);
+	free(s.frontier);
+	free(s.current_bitmap);
+	free(s.next_bitmap);
+	tp_deleteThreadPool(s.pool);
+	if (s.in != g && s.in != transposed) {
+		gr_deleteGraph(s.in);
+	}
+	return reached;
+}
+
+// Topological Sort
+
+/**
+ * Ordinamento topologico con l'algoritmo di Kahn: l'array "order" viene usato come coda dei vertici senza archi
+ * entranti residui, e al termine contiene l'ordinamento. Restituisce false se il grafo contiene un ciclo: in tal caso
+ * "order" contiene solamente i vertici che non raggiungono (e non appartengono a) nessun ciclo, in ordine topologico,
+ * e le posizioni successive non sono significative.
+ */
+bool gt_topologicalSort(graph* g, int* order) {
+	int vertices_number = g->vertices_number;
+	int* in_degrees = calloc((size_t)vertices_number + 1, sizeof(int));
+	if (!in_degrees) {
+		MEMORY_ERROR;
+	}
+	long arcs_number = g->offsets[vertices_number];
+	for (long arc = 0; arc < arcs_number; arc++) {
+		in_degrees[g->neighbors[arc]]++;
+	}
+	int tail = 0;
+	for (int v = 0; v < vertices_number; v++) {
+		if (in_degrees[v] == 0) {
+			order[tail++] = v;
+		}
+	}
+	for (int head = 0; head < tail; head++) {
+		int u = order[head];
+		for (long arc = g->offsets[u]; arc < g->offsets[u + 1]; arc++) {
+			int v = g->neighbors[arc];
+			if (--in_degrees[v] == 0) {
+				order[tail++] = v;
+			}
+		}
+	}
+	free(in_degrees);
+	return tail == vertices_number;
+}
+
+/**
+ * Ordinamento topologico tramite visita in profondità iterativa: i vertici vengono scritti in "order" a partire
+ * dal fondo nell'ordine in cui la visita li completa. La pila della visita occupa la parte iniziale dello stesso array
+ * (vertici in visita e vertici completati sono disgiunti, quindi le due parti non si sovrappongono), e per ogni
+ * livello della pila viene memorizzato l'arco da cui riprendere. Restituisce false se il grafo contiene un ciclo
+ * (rilevato come arco verso un vertice ancora in visita); in tal caso il contenuto di "order" non è significativo.
+ */
+bool gt_depthFirstTopologicalSort(graph* g, int* order) {
+	int vertices_number = g->vertices_number;
+	long* cursors = malloc(((size_t)vertices_number + 1) * sizeof(long));
+	unsigned char* states = calloc((size_t)vertices_number + 1, sizeof(unsigned char));
+	if (!cursors || !states) {
+		MEMORY_ERROR;
+	}
+	enum { UNVISITED = 0, ACTIVE, COMPLETED };
+	int completed = vertices_number;
+	bool acyclic = true;
+	for (int root = 0; root < vertices_number && acyclic; root++) {
+		if (states[root] != UNVISITED) {
+			continue;
+		}
+		int depth = 0;
+		order[depth] = root;
+		cursors[depth] = g->offsets[root];
+		states[root] = ACTIVE;
+		while (depth >= 0 && acyclic) {
+			int u = order[depth];
+			if (cursors[depth] < g->offsets[u + 1]) {
+				int v = g->neighbors[cursors[depth]++];
+				if (states[v] == UNVISITED) {
+					depth++;
+					order[depth] = v;
+					cursors[depth] = g->offsets[v];
+					states[v] = ACTIVE;
+				} else if (states[v] == ACTIVE) {
+					acyclic = false;
+				}
+			} else {
+				states[u] = COMPLETED;
+				depth--;
+				order[--completed] = u;
+			}
+		}
+	}
+	free(cursors);
+	free(states);
+	return acyclic;
+}
@@ -0,0 +1,21 @@
+#ifndef GRAPHTRAVERSAL_H_
+#define GRAPHTRAVERSAL_H_
+
+#include "Graph.h"
+
+#ifndef NO_PARENT
+#	define NO_PARENT (-1)
+#endif
+#define UNREACHED_DISTANCE (-1)
+
+// Breadth-First Search
+int gt_breadthFirstSearch(graph* g, int source, int* distances, int* parents); // OK
+int gt_parallelBreadthFirstSearch(graph* g, graph* transposed, int source, int threads_number,
+		int* distances, int* parents); // OK
+int gt_compressedBreadthFirstSearch(cgraph* g, int source, int* distances, int* parents); // OK
+
+// Topological Sort
+bool gt_topologicalSort(graph* g, int* order); // OK
+bool gt_depthFirstTopologicalSort(graph* g, int* order); // OK
+
+#endif
@@ -22,6 +22,8 @@
 #	define EMPTY_SIZE_ERROR(instr) printf("Error: Cannot execute \"%s\" function on empty heap.", instr )
 #endif
 
+#define DEFAULT_COMPACTION_FRACTION 0.5
+
 /**
  * Libreria che permette la creazione e gestione di un max-heap binario, implementato come arraylist.
  * 
@@ -34,12 +36,27 @@
  * <i>NOTA:</i> La numerazione degli elementi dell'Heap inizia da 1. Questo è dovuto alla facilità di implementazione
  * che si può ottenere adottando questo particolare accorgimento.
  * Dato un nodo [i], infatti, il nodo padre avrà indice (int)[i / 2], i nodi figli [i * 2] e [i * 2 + 1].
+ *
+ * <i>NOTA:</i> Un heap inizializzato con "bh_initLazyHeap" adotta la cancellazione "pigra": le funzioni
+ * "bh_deleteElement" e "bh_deleteElementAtPosition" si limitano a marcare l'elemento come cancellato (tombstone)
+ * in tempo costante, senza cercarlo né riorganizzare l'heap. Le tombstone vengono rimosse fisicamente quando
+ * raggiungono la radice, oppure tutte insieme (in tempo lineare) quando superano la frazione di heap indicata
+ * all'inizializzazione; il costo della rimozione è quindi O(1) ammortizzato per ogni cancellazione.
+ * Le funzioni che accedono all'heap per posizione lavorano sull'arraylist interno, che può contenere tombstone;
+ * tutte le altre funzioni le ignorano (eventualmente compattando l'heap prima di procedere).
  */
 
 /*
 typedef struct binaryheap {
 	arraylist* al;
 	int (*comparefunction)(void*, void*);
+	void (*markfunction)(void*);
+	bool (*ismarkedfunction)(void*);
+	void (*unmarkfunction)(void*);
+	void (*setpositionfunction)(void*, int);
+	int (*getpositionfunction)(void*);
+	int tombstones;
+	double compaction_fraction;
 } binaryheap;
 */
 
@@ -56,16 +73,54 @@ binaryheap* bh_initHeap(int (*compare)(void*, void*)) {
 	}
 	new_binaryheap->al = al_initList();
 	new_binaryheap->comparefunction = compare;
+	new_binaryheap->markfunction = NULL;
+	new_binaryheap->ismarkedfunction = NULL;
+	new_binaryheap->unmarkfunction = NULL;
+	new_binaryheap->setpositionfunction = NULL;
+	new_binaryheap->getpositionfunction = NULL;
+	new_binaryheap->tombstones = 0;
+	new_binaryheap->compaction_fraction = 0;
+	return new_binaryheap;
+}
+
+/**
+ * Inizializza un max-heap binario con cancellazione "pigra" (vedi la nota iniziale).
+ * La procedura "mark" marca un elemento come cancellato, la funzione "ismarked" restituisce true
+ * se l'elemento è stato marcato e la procedura "unmark" annulla la marcatura: tipicamente tutte e tre agiscono
+ * su un campo booleano dell'elemento. La marcatura viene annullata dall'heap non appena la tombstone viene rimossa
+ * fisicamente, per cui un elemento risulta marcato solamente finché la sua tombstone è presente nell'arraylist interno.
+ * La procedura "setposition" memorizza nell'elemento la sua posizione nell'heap, e viene chiamata ogni volta che
+ * l'elemento viene spostato; la funzione "getposition" la restituisce. In questo modo una tombstone può essere
+ * ripristinata senza cercarla nell'heap.
+ * Quando le tombstone superano la frazione "compaction_fraction" degli elementi presenti nell'arraylist
+ * interno, l'heap viene compattato. Se la frazione non è compresa fra 0 (escluso) e 1, viene utilizzato 0.5.
+ *
+ * <i>NOTA:</i> Un elemento cancellato continua ad essere utilizzato nei confronti finché non viene rimosso
+ * fisicamente: non deve quindi essere liberato dalla memoria prima di allora. Può invece essere modificato e
+ * reinserito nell'heap con "bh_insertElement", che in tal caso riutilizza la sua tombstone in tempo O(log n).
+ * Dopo una chiamata a "bh_compactHeap" è garantito che nessuna tombstone sia più presente nell'heap.
+ */
+binaryheap* bh_initLazyHeap(int (*compare)(void*, void*), void (*mark)(void*), bool (*ismarked)(void*),
+		void (*unmark)(void*), void (*setposition)(void*, int), int (*getposition)(void*),
+		double compaction_fraction) {
+	binaryheap* new_binaryheap = bh_initHeap(compare);
+	new_binaryheap->markfunction = mark;
+	new_binaryheap->ismarkedfunction = ismarked;
+	new_binaryheap->unmarkfunction = unmark;
+	new_binaryheap->setpositionfunction = setposition;
+	new_binaryheap->getpositionfunction = getposition;
+	new_binaryheap->compaction_fraction =
+		(compaction_fraction > 0 && compaction_fraction <= 1) ? compaction_fraction : DEFAULT_COMPACTION_FRACTION;
 	return new_binaryheap;
 }
 
 // Size
 
 /**
- * Restituisce il numero di elementi contenuti all'interno dell'Heap.
+ * Restituisce il numero di elementi contenuti all'interno dell'Heap, escluse le eventuali tombstone.
  */
 int bh_getHeapSize(binaryheap* h) {
-	return h->al->size;
+	return h->al->size - h->tombstones;
 }
 
 // Cancelling Heap
@@ -86,30 +141,172 @@ void bh_deleteHeap(binaryheap* h) {
  * Elimina l'heap, ripulendo la memoria occupata dalla lista interna e dagli oggetti contenuti in essa.
  * Questo significa che tutti gli elementi che compongono l'heap verranno irrimediabilmente persi, e non
  * potranno essere recuperati.
+ * Le eventuali tombstone non vengono liberate, poiché si tratta di elementi già cancellati.
  */
 void bh_purgeHeap(binaryheap* h) {
+	bh_compactHeap(h);
 	al_purgeList(h->al);
 	free(h);
 }
 
+// Static Utility Functions
+
+/**
+ * Scrive un elemento nella posizione data dell'heap, aggiornando la posizione memorizzata nell'elemento
+ * se l'heap ne tiene traccia (vedi "bh_initLazyHeap").
+ */
+static inline void bh_placeElement(binaryheap* h, int pos, void* element) {
+	h->al->array[HEAP_TO_ARRAY(pos)] = element;
+	if (h->setpositionfunction) {
+		h->setpositionfunction(element, pos);
+	}
+}
+
+/**
+ * Fa risalire l'elemento alla posizione data finché non è minore o uguale al proprio padre.
+ * L'algoritmo lavora "a buco": l'elemento viene tenuto da parte, i padri minori vengono spostati di un livello
+ * verso il basso (una sola scrittura ciascuno) e l'elemento viene scritto una sola volta nella posizione finale.
+ */
+static void bh_siftUp(binaryheap* h, int pos) {
+	void** array = h->al->array;
+	void* moving = array[HEAP_TO_ARRAY(pos)];
+	while (pos > 1 && h->comparefunction(moving, array[HEAP_TO_ARRAY(pos / 2)]) > 0) {
+		bh_placeElement(h, pos, array[HEAP_TO_ARRAY(pos / 2)]);
+		pos /= 2;
+	}
+	bh_placeElement(h, pos, moving);
+}
+
+/**
+ * Fa scendere l'elemento alla posizione data finché non è maggiore o uguale ai propri figli, considerando
+ * solamente le prime "size" posizioni dell'heap.
+ * Come per "bh_siftUp", l'algoritmo è iterativo e lavora "a buco", senza scambi e senza controlli sulle posizioni.
+ */
+static void bh_siftDown(binaryheap* h, int pos, int size) {
+	void** array = h->al->array;
+	void* moving = array[HEAP_TO_ARRAY(pos)];
+	int child;
+	while ((child = pos * 2) <= size) {
+		if (child < size && h->comparefunction(array[HEAP_TO_ARRAY(child + 1)], array[HEAP_TO_ARRAY(child)]) > 0) {
+			child++;	// Il secondo figlio è maggiore
+		}
+		if (h->comparefunction(array[HEAP_TO_ARRAY(child)], moving) <= 0) {
+			break;
+		}
+		bh_placeElement(h, pos, array[HEAP_TO_ARRAY(child)]);
+		pos = child;
+	}
+	bh_placeElement(h, pos, moving);
+}
+
+/**
+ * Ricostruisce la proprietà di heap sull'intero arraylist interno, in tempo lineare,
+ * facendo scendere tutti i nodi interni a partire dall'ultimo.
+ * Se l'heap tiene traccia delle posizioni, queste vengono prima aggiornate per tutti gli elementi,
+ * poiché l'arraylist può essere stato riorganizzato senza passare da "bh_placeElement".
+ */
+static void bh_heapify(binaryheap* h) {
+	if (h->setpositionfunction) {
+		for (int pos = 1; pos <= h->al->size; pos++) {
+			h->setpositionfunction(h->al->array[HEAP_TO_ARRAY(pos)], pos);
+		}
+	}
+	for (int pos = h->al->size / 2; pos >= 1; pos--) {
+		bh_siftDown(h, pos, h->al->size);
+	}
+}
+
+/**
+ * Ripristina la proprietà di heap attorno alla posizione data, considerando solamente le prime "size" posizioni:
+ * l'elemento viene fatto risalire se è maggiore del padre, altrimenti viene fatto scendere.
+ * È sufficiente quando la proprietà di heap è violata al più dal solo elemento in quella posizione.
+ */
+static void bh_restoreElementAtPosition(binaryheap* h, int pos, int size) {
+	if (pos > 1 && h->comparefunction(h->al->array[HEAP_TO_ARRAY(pos)], h->al->array[HEAP_TO_ARRAY(pos / 2)]) > 0) {
+		bh_siftUp(h, pos);
+	} else {
+		bh_siftDown(h, pos, size);
+	}
+}
+
+/**
+ * Restituisce true se l'heap adotta la cancellazione "pigra".
+ */
+static bool bh_isLazyHeap(binaryheap* h) {
+	return h->ismarkedfunction != NULL;
+}
+
+/**
+ * Rimuove fisicamente le tombstone che si trovano nella radice, finché questa non è un elemento valido.
+ */
+static void bh_pruneRoot(binaryheap* h) {
+	while (h->tombstones > 0 && h->ismarkedfunction(h->al->array[0])) {
+		bh_extractElementAtPosition(h, 1);
+	}
+}
+
+/**
+ * Marca un elemento come cancellato, in tempo costante.
+ * Se le tombstone superano la frazione di heap desiderata, l'heap viene compattato.
+ */
+static void bh_markTombstone(binaryheap* h, void* element) {
+	if (h->ismarkedfunction(element)) {
+		return;	// Già cancellato
+	}
+	h->markfunction(element);
+	h->tombstones++;
+	if (h->tombstones > h->compaction_fraction * h->al->size) {
+		bh_compactHeap(h);
+	}
+}
+
+// Compacting Heap
+
+/**
+ * Rimuove fisicamente tutte le tombstone dall'heap, con un'unica passata lineare sull'arraylist interno,
+ * e ricostruisce la proprietà di heap in tempo lineare. Le tombstone non vengono eliminate dalla memoria.
+ * Se l'heap non contiene tombstone (in particolare, se non adotta la cancellazione "pigra"), non fa nulla.
+ */
+void bh_compactHeap(binaryheap* h) {
+	if (h->tombstones == 0) {
+		return;
+	}
+	void** array = h->al->array;
+	int write = 0;
+	for (int read = 0; read < h->al->size; read++) {
+		if (!h->ismarkedfunction(array[read])) {
+			array[write++] = array[read];
+		} else {
+			h->unmarkfunction(array[read]);
+		}
+	}
+	h->al->size = write;
+	h->tombstones = 0;
+	bh_heapify(h);
+}
+
 // Inserting Elements
 
 /**
  * Inserisce un elemento all'interno dell'heap.
  * Non è possibile definire la posizione personalizzata in cui inserirlo poiché -per stessa implementazione dell'heap-
  * è la struttura stessa a definire la posizione di un elemento.
+ * Se l'heap adotta la cancellazione "pigra" e l'elemento è una tombstone ancora presente nell'heap, questa viene
+ * ripristinata (e riposizionata, nel caso in cui l'elemento sia stato modificato) invece di inserire un duplicato.
  */
 void bh_insertElement(binaryheap* h, void* new_element) {
-	al_insertLastElement(h->al, new_element);
-	int index = h->al->size;
-	while (index > 1) {
-		if (h->comparefunction(new_element, h->al->array[HEAP_TO_ARRAY(index / 2)]) > 0) {
-			al_swapTwoElements(h->al, HEAP_TO_ARRAY(index / 2), HEAP_TO_ARRAY(index));
-			index /= 2;
-		} else {
-			index = 1; // Esce dal ciclo
+	if (h->tombstones > 0 && h->ismarkedfunction(new_element)) {
+		h->unmarkfunction(new_element);
+		h->tombstones--;
+		int pos = h->getpositionfunction(new_element);
+		if (pos >= 1 && EXISTS_POSITION_IN_HEAP(h, pos) && h->al->array[HEAP_TO_ARRAY(pos)] == new_element) {
+			bh_restoreElementAtPosition(h, pos, h->al->size);
+			return;
 		}
+		// La tombstone non è presente nell'heap (l'elemento era stato cancellato senza esservi contenuto)
 	}
+	al_insertLastElement(h->al, new_element);
+	bh_siftUp(h, h->al->size);
 }
 
 /**
@@ -129,75 +326,152 @@ void bh_insertAllElements(binaryheap* h, arraylist* elements) {
  * Cancella la radice dell'heap e risistema i nodi restanti.
  */
 void bh_deleteRootElement(binaryheap* h) {
-	bh_deleteElementAtPosition(h, 1);
+	bh_extractRootElement(h);
 }
 
 /**
  * Cancella un elemento dell'Heap, dato come parametro il suo riferimento.
+ * Se l'heap adotta la cancellazione "pigra", l'elemento viene solamente marcato come cancellato, in tempo costante:
+ * in questo caso l'elemento deve essere effettivamente contenuto nell'heap.
  */
 void bh_deleteElement(binaryheap* h, void* element_to_delete) {
+	if (bh_isLazyHeap(h)) {
+		bh_markTombstone(h, element_to_delete);
+		return;
+	}
 	int pos = bh_getPositionOfElement(h, element_to_delete);
-	bh_deleteElementAtPosition(h, pos);
+	if (pos != -1) {
+		bh_deleteElementAtPosition(h, pos);
+	}
 }
 
 /**
  * Porta l'elemento nella posizione desiderata alla fine dell'arraylist.
  * Questo permette di eliminarlo più facilmente.
+ * Il buco lasciato dall'elemento scende fino a una foglia seguendo il figlio maggiore (un solo confronto per livello,
+ * contro i due di "bh_siftDown"), e l'ultimo elemento viene fatto risalire a partire da quella foglia: poiché
+ * l'ultimo elemento è quasi sempre piccolo, la risalita si ferma dopo pochi livelli ("bottom-up heapsort" di Floyd).
+ * Il cammino dalla radice alla foglia rimane ordinato, per cui il metodo vale per qualsiasi posizione di partenza.
  */
 static void bh_takeElementToEnd(binaryheap* h, int pos) {
-	// Controllo che non sia alla fine (aka: che abbia figli)
-	if (pos * 2 > (h->al->size)) {
-		// Non ho figli
-		al_swapTwoElements(h->al, HEAP_TO_ARRAY(pos), HEAP_TO_ARRAY(h->al->size));	// L'elemento da eliminare va scambiato con l'elemento in fondo
-		while (h->comparefunction(
-				h->al->array[HEAP_TO_ARRAY(pos)],
-				h->al->array[HEAP_TO_ARRAY(pos / 2)]) > 0) {
-			al_swapTwoElements(h->al, HEAP_TO_ARRAY(pos), HEAP_TO_ARRAY(pos / 2));
-			pos /= 2;
-		}
-		
-	} else if (pos * 2 == h->al->size) {
-		// Ho un figlio solo
-		// E' il caso più semplice, perchè non devo aggiornare ulteriormente i collegamenti.
-		al_swapTwoElements(h->al, HEAP_TO_ARRAY(pos), HEAP_TO_ARRAY(pos * 2));
-		
-	} else {
-		// Controllo i figli
-		if (h->comparefunction(
-				h->al->array[HEAP_TO_ARRAY(pos * 2)],				// Figlio SX (1)
-				h->al->array[HEAP_TO_ARRAY(pos * 2 + 1)]) > 0) {	// Figlio DX (2)
-			// Il primo figlio è maggiore
-			al_swapTwoElements(h->al, HEAP_TO_ARRAY(pos), HEAP_TO_ARRAY(pos * 2));
-			bh_takeElementToEnd(h, pos * 2);
-		} else {
-			// Il secondo figlio è maggiore
-			al_swapTwoElements(h->al, HEAP_TO_ARRAY(pos), HEAP_TO_ARRAY(pos * 2 + 1));
-			bh_takeElementToEnd(h, pos * 2 + 1);
+	int last = h->al->size;
+	if (pos == last) {
+		return;
+	}
+	void** array = h->al->array;
+	void* removed = array[HEAP_TO_ARRAY(pos)];
+	void* moved = array[HEAP_TO_ARRAY(last)];
+	int size = last - 1;
+	int child;
+	while ((child = pos * 2) <= size) {
+		if (child < size && h->comparefunction(array[HEAP_TO_ARRAY(child + 1)], array[HEAP_TO_ARRAY(child)]) > 0) {
+			child++;	// Il secondo figlio è maggiore
 		}
+		bh_placeElement(h, pos, array[HEAP_TO_ARRAY(child)]);
+		pos = child;
+	}
+	while (pos > 1 && h->comparefunction(moved, array[HEAP_TO_ARRAY(pos / 2)]) > 0) {
+		bh_placeElement(h, pos, array[HEAP_TO_ARRAY(pos / 2)]);
+		pos /= 2;
 	}
+	bh_placeElement(h, pos, moved);
+	array[HEAP_TO_ARRAY(last)] = removed;
 }
 
 /**
  * Data in ingresso la posizione <i>relativa all'heap</i> dell'elemento da eliminare, lo elimina dalla struttura.
  * L'elemento non viene eliminato dalla memoria ed è ancora raggiungibile se esistono puntatori ad esso.
+ * Se l'heap adotta la cancellazione "pigra", l'elemento viene solamente marcato come cancellato.
  */
 void bh_deleteElementAtPosition(binaryheap* h, int pos) {
+	if (bh_isLazyHeap(h)) {
+		bh_markTombstone(h, h->al->array[HEAP_TO_ARRAY(pos)]);
+		return;
+	}
 	bh_takeElementToEnd(h, pos);
 	al_deleteLastElement(h->al);
 }
 
 /**
- * Cancella dall'heap tutti gli elementi che soddisfano una data condizione, assicurandosi
- * che la struttura rimanga costantemente ben formattata (i.e. fa in modo che non venga infranta la
- * proprietà di heap).
+ * Gestisce un elemento rimosso dall'heap da una delle funzioni "...ByCondition":
+ * se viene passata una lista, l'elemento viene aggiunto ad essa; altrimenti, se richiesto, viene liberato dalla memoria.
+ */
+static void bh_disposeRemovedElement(void* element, arraylist* removed, bool purge) {
+	if (removed) {
+		al_insertLastElement(removed, element);
+	} else if (purge) {
+		free(element);
+	}
+}
+
+/**
+ * Restituisce il numero di rimozioni oltre il quale conviene compattare l'intero heap e ricostruirlo,
+ * piuttosto che rimuovere gli elementi uno alla volta: ogni rimozione singola costa O(log n), mentre
+ * la compattazione seguita dalla ricostruzione costa O(n).
  */
-void bh_deleteElementsByConditions(binaryheap* h, bool (*condition)(void*)) {
-	/// TODO better implementation?
-	for (int i = h->al->size; i > 0; i--) {		// Scorro a partire dal fondo perché questo mi permette di eseguire un numero inferiore di istruzioni (nell'altra funzione)
-		if (condition(h->al->array[HEAP_TO_ARRAY(i)])) {
-			bh_deleteElementAtPosition(h, i);
+static int bh_getBulkRemovalThreshold(int size) {
+	int log_size = 1;
+	while ((size >> log_size) > 0) {
+		log_size++;
+	}
+	return size / log_size;
+}
+
+/**
+ * Rimuove dall'heap tutti gli elementi che soddisfano una data condizione, restituendone il numero.
+ *
+ * L'heap viene scorso dal fondo, rimuovendo un elemento alla volta; se però il numero di rimozioni supera la soglia
+ * data da "bh_getBulkRemovalThreshold", la parte di heap non ancora controllata viene filtrata con un'unica passata
+ * lineare (che compatta l'arraylist interno) e la proprietà di heap viene ricostruita in tempo lineare.
+ *
+ * <i>NOTA:</i> Quando un elemento viene rimosso, la posizione corrente viene ricontrollata, poiché può esservi
+ * risalito un antenato non ancora esaminato. La condizione può quindi essere valutata più volte sullo stesso elemento.
+ */
+static int bh_removeElementsByCondition(binaryheap* h, bool (*condition)(void*), arraylist* removed, bool purge) {
+	bh_compactHeap(h);
+	int threshold = bh_getBulkRemovalThreshold(h->al->size);
+	int count = 0;
+	int pos = h->al->size;
+	while (pos >= 1) {
+		void* element = h->al->array[HEAP_TO_ARRAY(pos)];
+		if (!condition(element)) {
+			pos--;
+		} else if (count < threshold) {
+			// Rimozione singola
+			bh_takeElementToEnd(h, pos);
+			al_extractLastElement(h->al);
+			bh_disposeRemovedElement(element, removed, purge);
+			count++;
+			if (pos > h->al->size) {
+				pos = h->al->size;
+			}
+		} else {
+			// Troppe rimozioni: compatto le posizioni da 1 a pos (quelle successive sono già state controllate)
+			void** array = h->al->array;
+			int write = 0;
+			for (int read = 0; read < h->al->size; read++) {
+				if (read < pos && condition(array[read])) {
+					bh_disposeRemovedElement(array[read], removed, purge);
+					count++;
+				} else {
+					array[write++] = array[read];
+				}
+			}
+			h->al->size = write;
+			bh_heapify(h);
+			pos = 0;
 		}
 	}
+	return count;
+}
+
+/**
+ * Cancella dall'heap tutti gli elementi che soddisfano una data condizione, assicurandosi
+ * che la struttura rimanga costantemente ben formattata (i.e. fa in modo che non venga infranta la
+ * proprietà di heap). Gli elementi non vengono eliminati dalla memoria.
+ */
+void bh_deleteElementsByCondition(binaryheap* h, bool (*condition)(void*)) {
+	bh_removeElementsByCondition(h, condition, NULL, false);
 }
 
 // Purging Elements
@@ -207,8 +481,7 @@ void bh_deleteElementsByConditions(binaryheap* h, bool (*condition)(void*)) {
  * ossia quello in prima posizione.
  */
 void bh_purgeRootElement(binaryheap* h) {
-	bh_takeElementToEnd(h, 1);
-	al_purgeLastElement(h->al);
+	free(bh_extractRootElement(h));
 }
 
 /**
@@ -216,11 +489,16 @@ void bh_purgeRootElement(binaryheap* h) {
  * indicata come parametro. Questo non sarà più accessibile successivamente alla chiamata di questa funzione.
  */
 void bh_purgeElementAtPosition(binaryheap* h, int pos) {
-	bh_takeElementToEnd(h, pos);
-	al_purgeLastElement(h->al);
+	free(bh_extractElementAtPosition(h, pos));
 }
 
-void bh_purgeElementsByCondition(binaryheap* h, bool (*condition)(void*)); /// TODO
+/**
+ * Elimina dall'heap e dalla memoria del programma tutti gli elementi che soddisfano una data condizione,
+ * mantenendo valida la proprietà di heap.
+ */
+void bh_purgeElementsByCondition(binaryheap* h, bool (*condition)(void*)) {
+	bh_removeElementsByCondition(h, condition, NULL, true);
+}
 
 // Getting Elements
 
@@ -229,6 +507,7 @@ void bh_purgeElementsByCondition(binaryheap* h, bool (*condition)(void*)); /// T
  * che secondo la funzione comparatrice ha valore maggiore di tutti gli altri.
  */
 void* bh_getRootElement(binaryheap* h) {
+	bh_pruneRoot(h);
 	return al_getFirstElement(h->al);
 }
 
@@ -244,12 +523,20 @@ void* bh_getElementAtPosition(binaryheap* h, int pos) {
 	}
 }
 
-arraylist* bh_getElementsByCondition(binaryheap* h, bool (*condition)(void*)); /// TODO
+/**
+ * Restituisce una lista con i puntatori agli elementi che soddisfano la condizione passata come parametro.
+ * L'heap non viene modificato, e l'ordine degli elementi nella lista è quello dell'arraylist interno.
+ */
+arraylist* bh_getElementsByCondition(binaryheap* h, bool (*condition)(void*)) {
+	bh_compactHeap(h);
+	return al_getElementsByCondition(h->al, condition);
+}
 
 /**
  * Restituisce la lista interna all'heap.
  */
 arraylist* bh_getListOfElements(binaryheap* h) {
+	bh_compactHeap(h);
 	return h->al;
 }
 
@@ -259,8 +546,12 @@ arraylist* bh_getListOfElements(binaryheap* h) {
  * Estrae l'elemento radice dell'heap, arrangiando l'heap in modo che mantenga la proprietà di heap.
  */
 void* bh_extractRootElement(binaryheap* h) {
-	bh_extractElementAtPosition(h, 1);
-	return al_extractLastElement(h->al);
+	bh_pruneRoot(h);
+	if (h->al->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("bh_extractRootElement");
+		return NULL;
+	}
+	return bh_extractElementAtPosition(h, 1);
 }
 
 /**
@@ -269,7 +560,12 @@ void* bh_extractRootElement(binaryheap* h) {
  */
 void* bh_extractElementAtPosition(binaryheap* h, int pos) {
 	bh_takeElementToEnd(h, pos);
-	return al_extractLastElement(h->al);
+	void* extracted = al_extractLastElement(h->al);
+	if (h->tombstones > 0 && h->ismarkedfunction(extracted)) {
+		h->unmarkfunction(extracted);
+		h->tombstones--;
+	}
+	return extracted;
 }
 
 /**
@@ -280,12 +576,7 @@ void* bh_extractElementAtPosition(binaryheap* h, int pos) {
  */
 arraylist* bh_extractElementsByCondition(binaryheap* h, bool (*condition)(void*)) {
 	arraylist* extracted = al_initList();
-	for (int i = h->al->size; i > 0; i--) {		// Scorro a partire dal fondo perché questo mi permette di eseguire un nuemro inferiore di istruzioni (nell'altra funzione)
-		if (condition(h->al->array[HEAP_TO_ARRAY(i)])) {
-			void* elem_extracted = bh_extractElementAtPosition(h, i);
-			al_insertLastElement(extracted, elem_extracted);
-		}
-	}
+	bh_removeElementsByCondition(h, condition, extracted, false);
 	return extracted;
 }
 
@@ -296,6 +587,7 @@ arraylist* bh_extractElementsByCondition(binaryheap* h, bool (*condition)(void*)
  * Se assente, viene restituito il valore -1;
  */
 int bh_getPositionOfElement(binaryheap* h, void* element_to_find) {
+	bh_compactHeap(h);
 	int pos = al_getPositionOfElement(h->al, element_to_find);
 	if (pos == -1) {
 		return pos;
@@ -351,12 +643,25 @@ static bool bh_containsElementInSubheap(binaryheap* h, void* element_content, in
  * per dimensioni maggiori.
  */
 bool bh_containsElement(binaryheap* h, void* element_content) {
+	bh_compactHeap(h);
 	return bh_containsElementInSubheap(h, element_content, 1);
 }
 
-bool bh_containsElementByCondition(binaryheap* h, bool (*condition)(void*)); /// TODO
+/**
+ * Verifica che all'interno dell'heap sia presente almeno un elemento che soddisfi una data condizione.
+ */
+bool bh_containsElementByCondition(binaryheap* h, bool (*condition)(void*)) {
+	bh_compactHeap(h);
+	return al_containsElementByCondition(h->al, condition);
+}
 
-int bh_countElementsByCondition(binaryheap* h, bool (*condition)(void*)); /// TODO
+/**
+ * Restituisce il numero di elementi dell'heap che soddisfano una data condizione.
+ */
+int bh_countElementsByCondition(binaryheap* h, bool (*condition)(void*)) {
+	bh_compactHeap(h);
+	return al_countElementsByCondition(h->al, condition);
+}
 
 // Cloning Heap
 
@@ -372,6 +677,7 @@ void* bh_cumulateElements(binaryheap* h, void* (*binaryOperation)(void*, void*))
  * Restituisce l'elemento massimo dell'Heap, che per stessa definizione di max-heap si trova in testa.
  */
 void* bh_getMaximumElement(binaryheap* h) {
+	bh_pruneRoot(h);
 	if (h->al->size > EMPTY_SIZE) {
 		return h->al->array[0];
 	} else {
@@ -381,24 +687,24 @@ void* bh_getMaximumElement(binaryheap* h) {
 }
 
 /**
- * Restituisce l'elemento minimo dell'heap, attraversandolo di padre in figlio.
- * Per ogni iterazione viene selezionato il figlio con valore inferiore.
- * L'algoritmo ha complessità log_2(n).
+ * Restituisce l'elemento minimo dell'heap.
+ * In un max-heap il minimo può trovarsi in una qualsiasi delle foglie, ossia nelle posizioni da (size / 2 + 1) a size:
+ * la funzione le scorre tutte, con complessità lineare.
+ * Se è necessario accedere frequentemente ad entrambi gli estremi, si consiglia di utilizzare il min-max heap
+ * (vedi "MinMaxHeap.h"), che li fornisce in tempo costante.
  */
 void* bh_getMinimumElement(binaryheap* h) {
-	/// TODO da controllare, non sono sicuro che funzioni.
+	bh_compactHeap(h);
 	if (h->al->size == EMPTY_SIZE) {
 		EMPTY_SIZE_ERROR("bh_getMinimumElement");
 		return NULL;
 	} else {
-		int minimum_index = 1;
-		while (minimum_index < h->al->size) {
+		int minimum_index = h->al->size / 2 + 1;
+		for (int i = minimum_index + 1; i <= h->al->size; i++) {
 			if (h->comparefunction(
-					h->al->array[HEAP_TO_ARRAY(minimum_index * 2)],
-					h->al->array[HEAP_TO_ARRAY(minimum_index * 2 + 1)]) > 0) {
-				minimum_index = minimum_index * 2;
-			} else {
-				minimum_index = minimum_index * 2 + 1;
+					h->al->array[HEAP_TO_ARRAY(i)],
+					h->al->array[HEAP_TO_ARRAY(minimum_index)]) < 0) {
+				minimum_index = i;
 			}
 		}
 		return h->al->array[HEAP_TO_ARRAY(minimum_index)];
@@ -457,6 +763,7 @@ static char* bh_getSubtreeString(binaryheap* h, char* (*toStringFunction)(void*)
  * Restituisce la rappresentazione dell'Heap binario come stringa.
  */
 char* bh_heapToString(binaryheap* h, char* (*toStringFunction)(void*)) {
+	bh_compactHeap(h);
 	char* str = malloc(strlen(STRING_TITLE_HEAP) + 1);
 	sprintf(str, STRING_TITLE_HEAP, h->al->size);
 	char* aux = bh_getSubtreeString(h, toStringFunction, 1, 0);
@@ -591,6 +898,106 @@ char* stringifyMyNumber(void* obj) {
 	return str;
 }
 
+typedef struct {
+	int key;
+	bool deleted;
+	int position;
+} lazyitem;
+
+int compareLazyItems(void* obj1, void* obj2) {
+	return ((lazyitem*)obj1)->key - ((lazyitem*)obj2)->key;
+}
+
+void markLazyItem(void* obj) {
+	((lazyitem*)obj)->deleted = true;
+}
+
+bool isMarkedLazyItem(void* obj) {
+	return ((lazyitem*)obj)->deleted;
+}
+
+void unmarkLazyItem(void* obj) {
+	((lazyitem*)obj)->deleted = false;
+}
+
+void setLazyItemPosition(void* obj, int position) {
+	((lazyitem*)obj)->position = position;
+}
+
+int getLazyItemPosition(void* obj) {
+	return ((lazyitem*)obj)->position;
+}
+
+/**
+ * Verifica la cancellazione "pigra": cancella alcuni elementi, ne modifica uno cancellato e lo reinserisce,
+ * e controlla che le estrazioni restituiscano tutti e soli gli elementi validi in ordine decrescente.
+ * Restituisce il numero di errori riscontrati.
+ */
+int testLazyHeap(int dim) {
+	int errors = 0;
+	lazyitem* items = malloc(sizeof(lazyitem) * dim);
+	binaryheap* lh = bh_initLazyHeap(compareLazyItems, markLazyItem, isMarkedLazyItem, unmarkLazyItem,
+		setLazyItemPosition, getLazyItemPosition, 0.9);
+	for (int i = 0; i < dim; i++) {
+		items[i].key = i;
+		items[i].deleted = false;
+		bh_insertElement(lh, &items[i]);
+	}
+	// Cancello gli elementi di indice pari, poi ne reinserisco alcuni con chiave modificata
+	for (int i = 0; i < dim; i += 2) {
+		bh_deleteElement(lh, &items[i]);
+	}
+	for (int i = 0; i < dim; i += 4) {
+		items[i].key = dim + i;
+		bh_insertElement(lh, &items[i]);
+	}
+	// Un elemento cancellato due volte e reinserito dopo l'estrazione della radice
+	bh_deleteElement(lh, &items[1]);
+	bh_deleteElement(lh, &items[1]);
+	bh_deleteRootElement(lh);
+	bh_insertElement(lh, &items[1]);
+	// Un elemento esterno cancellato per errore viene comunque inserito una sola volta
+	lazyitem external = {dim / 2, false, 0};
+	bh_deleteElement(lh, &external);
+	bh_insertElement(lh, &external);
+	
+	for (int pos = 1; pos <= lh->al->size; pos++) {
+		if (getLazyItemPosition(bh_getElementAtPosition(lh, pos)) != pos) {
+			printf("Posizione errata per l'elemento in posizione %d\n", pos);
+			errors++;
+		}
+	}
+	int expected = dim / 2 + (dim + 3) / 4;
+	if (bh_getHeapSize(lh) != expected) {
+		printf("Dimensione errata: %d invece di %d\n", bh_getHeapSize(lh), expected);
+		errors++;
+	}
+	int previous = dim * 2;
+	int extracted = 0;
+	while (bh_getHeapSize(lh) > 0) {
+		lazyitem* item = bh_extractRootElement(lh);
+		if (item->deleted || item->key > previous) {
+			printf("Estratto l'elemento errato %d\n", item->key);
+			errors++;
+		}
+		previous = item->key;
+		extracted++;
+	}
+	if (extracted != expected || lh->al->size != 0 || lh->tombstones != 0) {
+		printf("Estratti %d elementi su %d, %d tombstone residue\n", extracted, expected, lh->tombstones);
+		errors++;
+	}
+	for (int i = 0; i < dim; i++) {
+		if (items[i].deleted) {
+			printf("L'elemento %d è rimasto marcato\n", i);
+			errors++;
+		}
+	}
+	bh_deleteHeap(lh);
+	free(items);
+	return errors;
+}
+
 #endif
 
 ///////////////////////// MAIN //////////////////////////////
@@ -631,7 +1038,11 @@ int main(void) {
 	// Cleaning
 	bh_purgeHeap(hh);
 	
-	return 0;
+	// Cancellazione "pigra"
+	int errors = testLazyHeap(dim) + testLazyHeap(dim * 50);
+	printf("Heap con cancellazione pigra: %d errori\n", errors);
+	
+	return errors != 0;
 }
 
 // TESTING VARIO //
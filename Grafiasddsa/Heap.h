@@ -6,14 +6,27 @@
 typedef struct binaryheap {
 	arraylist* al;
 	int (*comparefunction)(void*, void*);
+	void (*markfunction)(void*);
+	bool (*ismarkedfunction)(void*);
+	void (*unmarkfunction)(void*);
+	void (*setpositionfunction)(void*, int);
+	int (*getpositionfunction)(void*);
+	int tombstones;
+	double compaction_fraction;
 } binaryheap;
 
 // Initializing Heap
 binaryheap* bh_initHeap(int (*compare)(void*, void*)); // OK
+binaryheap* bh_initLazyHeap(int (*compare)(void*, void*), void (*mark)(void*), bool (*ismarked)(void*),
+		void (*unmark)(void*), void (*setposition)(void*, int), int (*getposition)(void*),
+		double compaction_fraction); // OK
 
 // Size
 int bh_getHeapSize(binaryheap* h); // OK
 
+// Compacting Heap
+void bh_compactHeap(binaryheap* h); // OK
+
 // Cancelling Heap
 void bh_deleteHeap(binaryheap* h); // OK
 void bh_purgeHeap(binaryheap* h); // OK
@@ -24,40 +37,40 @@ void bh_insertAllElements(binaryheap* h, arraylist* elements); // OK
 
 // Deleting Elements
 void bh_deleteRootElement(binaryheap* h); // OK
-void bh_deleteElement(binaryheap* h, void* element_to_delete);
+void bh_deleteElement(binaryheap* h, void* element_to_delete); // OK
 void bh_deleteElementAtPosition(binaryheap* h, int pos); // OK
-void bh_deleteElementsByCondition(binaryheap* h, bool (*condition)(void*));
+void bh_deleteElementsByCondition(binaryheap* h, bool (*condition)(void*)); // OK
 
 // Purging Elements
 void bh_purgeRootElement(binaryheap* h); // OK
 void bh_purgeElementAtPosition(binaryheap* h, int pos); // OK
-void bh_purgeElementsByCondition(binaryheap* h, bool (*condition)(void*)); /// TODO
+void bh_purgeElementsByCondition(binaryheap* h, bool (*condition)(void*)); // OK
 
 // Getting Elements
 void* bh_getRootElement(binaryheap* h); // OK
 void* bh_getElementAtPosition(binaryheap* h, int pos); // OK
-arraylist* bh_getElementsByCondition(binaryheap* h, bool (*condition)(void*)); /// TODO
+arraylist* bh_getElementsByCondition(binaryheap* h, bool (*condition)(void*)); // OK
 arraylist* bh_getListOfElements(binaryheap* h);
 
 // Extracting Elements
 void* bh_extractRootElement(binaryheap* h); // OK
 void* bh_extractElementAtPosition(binaryheap* h, int pos); // OK
-arraylist* bh_extractElementsByCondition(binaryheap* h, bool (*condition)(void*));
+arraylist* bh_extractElementsByCondition(binaryheap* h, bool (*condition)(void*)); // OK
 
 // Searching Elements
 bool bh_containsElement(binaryheap* h, void* element_content); // OK
-bool bh_containsElementByCondition(binaryheap* h, bool (*condition)(void*)); /// TODO
-int bh_countElementsByCondition(binaryheap* h, bool (*condition)(void*)); /// TODO
+bool bh_containsElementByCondition(binaryheap* h, bool (*condition)(void*)); // OK
+int bh_countElementsByCondition(binaryheap* h, bool (*condition)(void*)); // OK
 int bh_getPositionOfElement(binaryheap* h, void* element_to_find);
 
 // Cloning Heap
 binaryheap* bh_cloneHeap(binaryheap* h, void* (*clone)(void*)); /// TODO
 
 // Generic Operations On Elements
-void bl_iterateOnElements(binaryheap* h, void (*procedure)(void*)); /// TODO
-void* bl_cumulateElements(binaryheap* h, void* (*binaryOperation)(void*, void*)); /// TODO
+void bh_iterateOnElements(binaryheap* h, void (*procedure)(void*)); /// TODO
+void* bh_cumulateElements(binaryheap* h, void* (*binaryOperation)(void*, void*)); /// TODO
 void* bh_getMaximumElement(binaryheap* h);
-void* bh_getMinimumElement(binaryheap* h);
+void* bh_getMinimumElement(binaryheap* h); // OK
 
 // Visualizing Heap
 char* bh_heapToString(binaryheap* h, char* (*toStringFunction)(void*));
@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "IndexedHeap.h"
+
+#ifndef POSITION_OPERATIONS
+#	define POSITION_OPERATIONS
+#	define ARRAY_TO_HEAP(x) (x + 1)
+#	define HEAP_TO_ARRAY(x) (x - 1)
+#endif
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef EMPTY_SIZE
+#	define EMPTY_SIZE 0
+#	define EMPTY_SIZE_ERROR(instr) printf("Error: Cannot execute \"%s\" function on empty heap.", instr )
+#endif
+
+#define NOT_IN_HEAP 0
+
+/**
+ * Libreria che implementa un max-heap binario "indicizzato", i cui elementi sono gli interi da 0 a (items_number - 1),
+ * ciascuno con una chiave in virgola mobile.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Oltre all'array dell'heap (che contiene le coppie chiave-elemento, come il dkeyheap), la struttura mantiene l'array
+ * "positions", che associa ad ogni elemento la sua posizione nell'heap (oppure NOT_IN_HEAP). Questo permette di
+ * controllare la presenza di un elemento e di aumentarne la chiave ("promozione") in tempo O(log n), senza ricerche.
+ * Si tratta della struttura tipicamente utilizzata negli algoritmi sui grafi (come Dijkstra e Prim), in cui gli
+ * elementi sono i vertici.
+ *
+ * <i>NOTA:</i> Come il binaryheap, l'heap è formalizzato come max-heap: la promozione di un elemento corrisponde
+ * all'operazione "decrease-key" di un min-heap. Per ottenere il min-heap è sufficiente cambiare segno alle chiavi.
+ *
+ * <i>NOTA:</i> Tutta la memoria (proporzionale a items_number) viene allocata all'inizializzazione, e nessuna
+ * operazione successiva effettua allocazioni. La numerazione delle posizioni inizia da 1, come per il binaryheap.
+ */
+
+/*
+typedef struct indexedheap_entry {
+	double key;
+	int item;
+} indexedheap_entry;
+
+typedef struct indexedheap {
+	int size;
+	int items_number;
+	indexedheap_entry* array;
+	int* positions;
+} indexedheap;
+*/
+
+// Static Utility Functions
+
+/**
+ * Scrive una coppia nella posizione data, aggiornando la posizione dell'elemento.
+ */
+static void ih_placeEntry(indexedheap* h, int pos, indexedheap_entry entry) {
+	h->array[HEAP_TO_ARRAY(pos)] = entry;
+	h->positions[entry.item] = pos;
+}
+
+/**
+ * Fa risalire "a buco" la coppia data a partire dalla posizione indicata.
+ */
+static void ih_siftUp(indexedheap* h, int pos, indexedheap_entry moving) {
+	while (pos > 1 && moving.key > h->array[HEAP_TO_ARRAY(pos / 2)].key) {
+		ih_placeEntry(h, pos, h->array[HEAP_TO_ARRAY(pos / 2)]);
+		pos /= 2;
+	}
+	ih_placeEntry(h, pos, moving);
+}
+
+/**
+ * Fa scendere "a buco" la coppia data a partire dalla posizione indicata.
+ */
+static void ih_siftDown(indexedheap* h, int pos, indexedheap_entry moving) {
+	indexedheap_entry* array = h->array;
+	int size = h->size;
+	int child;
+	while ((child = pos * 2) <= size) {
+		if (child < size && array[HEAP_TO_ARRAY(child + 1)].key > array[HEAP_TO_ARRAY(child)].key) {
+			child++;
+		}
+		if (array[HEAP_TO_ARRAY(child)].key <= moving.key) {
+			break;
+		}
+		ih_placeEntry(h, pos, array[HEAP_TO_ARRAY(child)]);
+		pos = child;
+	}
+	ih_placeEntry(h, pos, moving);
+}
+
+// Initializing Heap
+
+/**
+ * Inizializza un heap vuoto per gli elementi da 0 a (items_number - 1).
+ */
+indexedheap* ih_initHeap(int items_number) {
+	indexedheap* new_heap = malloc(sizeof(indexedheap));
+	if (!new_heap) {
+		MEMORY_ERROR;
+	}
+	new_heap->size = 0;
+	new_heap->items_number = items_number;
+	new_heap->array = malloc(((size_t)items_number + 1) * sizeof(indexedheap_entry));
+	new_heap->positions = calloc((size_t)items_number + 1, sizeof(int));
+	if (!new_heap->array || !new_heap->positions) {
+		MEMORY_ERROR;
+	}
+	return new_heap;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di elementi contenuti all'interno dell'heap.
+ */
+int ih_getHeapSize(indexedheap* h) {
+	return h->size;
+}
+
+// Cancelling Heap
+
+/**
+ * Elimina l'heap, ripulendo la memoria occupata dai suoi array.
+ */
+void ih_deleteHeap(indexedheap* h) {
+	free(h->array);
+	free(h->positions);
+	free(h);
+}
+
+/**
+ * Svuota l'heap, in tempo proporzionale al numero di elementi contenuti (e non al numero di elementi possibili),
+ * in modo che possa essere riutilizzato senza nuove allocazioni.
+ */
+void ih_clearHeap(indexedheap* h) {
+	for (int pos = 1; pos <= h->size; pos++) {
+		h->positions[h->array[HEAP_TO_ARRAY(pos)].item] = NOT_IN_HEAP;
+	}
+	h->size = 0;
+}
+
+// Inserting Items
+
+/**
+ * Inserisce un elemento (non ancora presente) con la chiave data.
+ */
+void ih_insertItem(indexedheap* h, int item, double key) {
+	indexedheap_entry moving = {key, item};
+	ih_siftUp(h, ++h->size, moving);
+}
+
+/**
+ * Aumenta la chiave di un elemento presente nell'heap, facendolo risalire.
+ * Se la nuova chiave non è maggiore di quella attuale, l'heap non viene modificato.
+ */
+void ih_promoteItem(indexedheap* h, int item, double key) {
+	int pos = h->positions[item];
+	if (key > h->array[HEAP_TO_ARRAY(pos)].key) {
+		indexedheap_entry moving = {key, item};
+		ih_siftUp(h, pos, moving);
+	}
+}
+
+/**
+ * Inserisce l'elemento se non è presente, altrimenti ne aumenta la chiave (se maggiore di quella attuale).
+ * Restituisce true se l'elemento è stato inserito.
+ */
+bool ih_insertOrPromoteItem(indexedheap* h, int item, double key) {
+	if (h->positions[item] == NOT_IN_HEAP) {
+		ih_insertItem(h, item, key);
+		return true;
+	}
+	ih_promoteItem(h, item, key);
+	return false;
+}
+
+// Getting Items
+
+/**
+ * Restituisce l'elemento con la chiave massima, oppure -1 se l'heap è vuoto.
+ */
+int ih_getRootItem(indexedheap* h) {
+	if (h->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("ih_getRootItem");
+		return -1;
+	}
+	return h->array[0].item;
+}
+
+/**
+ * Restituisce la chiave massima. Se l'heap è vuoto restituisce 0.
+ */
+double ih_getRootKey(indexedheap* h) {
+	if (h->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("ih_getRootKey");
+		return 0;
+	}
+	return h->array[0].key;
+}
+
+/**
+ * Restituisce la chiave di un elemento presente nell'heap.
+ */
+double ih_getItemKey(indexedheap* h, int item) {
+	return h->array[HEAP_TO_ARRAY(h->positions[item])].key;
+}
+
+// Extracting Items
+
+/**
+ * Estrae l'elemento con la chiave massima, oppure -1 se l'heap è vuoto.
+ * Se il puntatore "key" non è NULL, vi viene scritta la chiave.
+ */
+int ih_extractRootItem(indexedheap* h, double* key) {
+	if (h->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("ih_extractRootItem");
+		return -1;
+	}
+	indexedheap_entry root = h->array[0];
+	if (key) {
+		*key = root.key;
+	}
+	h->positions[root.item] = NOT_IN_HEAP;
+	indexedheap_entry moving = h->array[HEAP_TO_ARRAY(h->size)];
+	if (--h->size > EMPTY_SIZE) {
+		ih_siftDown(h, 1, moving);
+	}
+	return root.item;
+}
+
+// Searching Items
+
+/**
+ * Restituisce true se l'elemento è contenuto nell'heap, in tempo costante.
+ */
+bool ih_containsItem(indexedheap* h, int item) {
+	return h->positions[item] != NOT_IN_HEAP;
+}
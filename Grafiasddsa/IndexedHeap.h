@@ -0,0 +1,44 @@
+#ifndef INDEXEDHEAP_H_
+#define INDEXEDHEAP_H_
+
+#include <stdbool.h>
+
+typedef struct indexedheap_entry {
+	double key;
+	int item;
+} indexedheap_entry;
+
+typedef struct indexedheap {
+	int size;
+	int items_number;
+	indexedheap_entry* array;
+	int* positions;
+} indexedheap;
+
+// Initializing Heap
+indexedheap* ih_initHeap(int items_number); // OK
+
+// Size
+int ih_getHeapSize(indexedheap* h); // OK
+
+// Cancelling Heap
+void ih_deleteHeap(indexedheap* h); // OK
+void ih_clearHeap(indexedheap* h); // OK
+
+// Inserting Items
+void ih_insertItem(indexedheap* h, int item, double key); // OK
+void ih_promoteItem(indexedheap* h, int item, double key); // OK
+bool ih_insertOrPromoteItem(indexedheap* h, int item, double key); // OK
+
+// Getting Items
+int ih_getRootItem(indexedheap* h); // OK
+double ih_getRootKey(indexedheap* h); // OK
+double ih_getItemKey(indexedheap* h, int item); // OK
+
+// Extracting Items
+int ih_extractRootItem(indexedheap* h, double* key); // OK
+
+// Searching Items
+bool ih_containsItem(indexedheap* h, int item); // OK
+
+#endif
@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "KeyHeap.h"
+
+#ifndef POSITION_OPERATIONS
+#	define POSITION_OPERATIONS
+#	define ARRAY_TO_HEAP(x) (x + 1)
+#	define HEAP_TO_ARRAY(x) (x - 1)
+#endif
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef EMPTY_SIZE
+#	define EMPTY_SIZE 0
+#	define EMPTY_SIZE_ERROR(instr) printf("Error: Cannot execute \"%s\" function on empty heap.", instr )
+#endif
+
+#define INCREASING_FACTOR 2
+#define DEFAULT_CAPACITY 16
+#define MINIMUM_CAPACITY 1
+
+/**
+ * Libreria che permette la creazione e gestione di max-heap binari con chiave numerica "in linea".
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * A differenza del binaryheap, ogni posizione dell'array interno contiene la coppia (chiave, elemento):
+ * i confronti avvengono direttamente sulle chiavi, senza chiamate alla funzione di comparazione e senza
+ * dereferenziare gli elementi. In questo modo ogni operazione accede solamente all'array dell'heap.
+ * Sono disponibili due varianti:
+ * - keyheap (prefisso "kh_"), con chiavi intere a 64 bit;
+ * - dkeyheap (prefisso "dkh_"), con chiavi in virgola mobile a doppia precisione.
+ *
+ * <i>NOTA:</i> Come il binaryheap, l'heap è formalizzato come max-heap: la radice ha la chiave maggiore.
+ * Per ottenere il min-heap corrispondente, è sufficiente inserire le chiavi cambiate di segno.
+ *
+ * <i>NOTA:</i> La capacità dell'array interno viene raddoppiata quando necessario, ma non viene mai ridotta
+ * durante le estrazioni: in questo modo le estrazioni non effettuano mai riallocazioni.
+ *
+ * <i>NOTA:</i> La numerazione degli elementi inizia da 1, come per il binaryheap.
+ *
+ * Le due varianti differiscono solamente per il tipo della chiave: ogni gruppo di funzioni è quindi scritto una sola
+ * volta, come macro parametrizzata sul prefisso, sui tipi dell'heap e della posizione, e sul tipo della chiave, ed è
+ * istanziato per entrambe. I confronti restano così operatori nativi sulla chiave, senza chiamate a funzione.
+ */
+
+/*
+typedef struct keyheap_entry {
+	int64_t key;
+	void* data;
+} keyheap_entry;
+
+typedef struct keyheap {
+	int size;
+	int capacity;
+	keyheap_entry* array;
+} keyheap;
+
+typedef struct dkeyheap_entry {
+	double key;
+	void* data;
+} dkeyheap_entry;
+
+typedef struct dkeyheap {
+	int size;
+	int capacity;
+	dkeyheap_entry* array;
+} dkeyheap;
+*/
+
+// Initializing Heap
+
+/**
+ * Inizializza un heap vuoto con capacità iniziale personalizzata ("..._initHeapWithCapacity"),
+ * oppure con capacità iniziale di default ("..._initHeap").
+ */
+#define KEYHEAP_INIT_FUNCTIONS(prefix, heap_type, entry_type) \
+	heap_type* prefix##_initHeapWithCapacity(int cap) { \
+		heap_type* new_heap = malloc(sizeof(heap_type)); \
+		if (!new_heap) { \
+			MEMORY_ERROR; \
+		} \
+		new_heap->size = 0; \
+		new_heap->capacity = cap > MINIMUM_CAPACITY ? cap : MINIMUM_CAPACITY; \
+		new_heap->array = malloc(new_heap->capacity * sizeof(entry_type)); \
+		if (!new_heap->array) { \
+			MEMORY_ERROR; \
+		} \
+		return new_heap; \
+	} \
+	\
+	heap_type* prefix##_initHeap() { \
+		return prefix##_initHeapWithCapacity(DEFAULT_CAPACITY); \
+	}
+
+KEYHEAP_INIT_FUNCTIONS(kh, keyheap, keyheap_entry)
+KEYHEAP_INIT_FUNCTIONS(dkh, dkeyheap, dkeyheap_entry)
+
+// Size
+
+/**
+ * Restituisce il numero di elementi contenuti all'interno dell'heap.
+ */
+#define KEYHEAP_SIZE_FUNCTIONS(prefix, heap_type) \
+	int prefix##_getHeapSize(heap_type* h) { \
+		return h->size; \
+	}
+
+KEYHEAP_SIZE_FUNCTIONS(kh, keyheap)
+KEYHEAP_SIZE_FUNCTIONS(dkh, dkeyheap)
+
+// Cancelling Heap
+
+/**
+ * Elimina l'heap, senza eliminare gli oggetti contenuti in esso ("..._deleteHeap"),
+ * oppure insieme agli oggetti contenuti in esso ("..._purgeHeap").
+ */
+#define KEYHEAP_CANCEL_FUNCTIONS(prefix, heap_type) \
+	void prefix##_deleteHeap(heap_type* h) { \
+		free(h->array); \
+		free(h); \
+	} \
+	\
+	void prefix##_purgeHeap(heap_type* h) { \
+		for (int i = 0; i < h->size; i++) { \
+			free(h->array[i].data); \
+		} \
+		prefix##_deleteHeap(h); \
+	}
+
+KEYHEAP_CANCEL_FUNCTIONS(kh, keyheap)
+KEYHEAP_CANCEL_FUNCTIONS(dkh, dkeyheap)
+
+// Inserting Elements
+
+/**
+ * Inserisce un elemento con la chiave data. La risalita lavora "a buco", confrontando direttamente le chiavi.
+ */
+#define KEYHEAP_INSERT_FUNCTIONS(prefix, heap_type, entry_type, key_type) \
+	void prefix##_insertElement(heap_type* h, key_type key, void* new_element) { \
+		if (h->size == h->capacity) { \
+			h->capacity *= INCREASING_FACTOR; \
+			h->array = realloc(h->array, h->capacity * sizeof(entry_type)); \
+			if (!h->array) { \
+				MEMORY_ERROR; \
+			} \
+		} \
+		entry_type* array = h->array; \
+		int pos = ++h->size; \
+		while (pos > 1 && key > array[HEAP_TO_ARRAY(pos / 2)].key) { \
+			array[HEAP_TO_ARRAY(pos)] = array[HEAP_TO_ARRAY(pos / 2)]; \
+			pos /= 2; \
+		} \
+		array[HEAP_TO_ARRAY(pos)].key = key; \
+		array[HEAP_TO_ARRAY(pos)].data = new_element; \
+	}
+
+KEYHEAP_INSERT_FUNCTIONS(kh, keyheap, keyheap_entry, int64_t)
+KEYHEAP_INSERT_FUNCTIONS(dkh, dkeyheap, dkeyheap_entry, double)
+
+// Deleting Elements
+
+/**
+ * Cancella la radice dell'heap. L'elemento non viene eliminato dalla memoria.
+ */
+#define KEYHEAP_DELETE_FUNCTIONS(prefix, heap_type) \
+	void prefix##_deleteRootElement(heap_type* h) { \
+		prefix##_extractRootElement(h, NULL); \
+	}
+
+KEYHEAP_DELETE_FUNCTIONS(kh, keyheap)
+KEYHEAP_DELETE_FUNCTIONS(dkh, dkeyheap)
+
+// Getting Elements
+
+/**
+ * Restituisce la chiave della radice, ossia la chiave massima ("..._getRootKey"; se l'heap è vuoto restituisce 0),
+ * oppure l'elemento associato ad essa ("..._getRootElement").
+ */
+#define KEYHEAP_GET_FUNCTIONS(prefix, heap_type, key_type) \
+	key_type prefix##_getRootKey(heap_type* h) { \
+		if (h->size == EMPTY_SIZE) { \
+			EMPTY_SIZE_ERROR(#prefix "_getRootKey"); \
+			return 0; \
+		} \
+		return h->array[0].key; \
+	} \
+	\
+	void* prefix##_getRootElement(heap_type* h) { \
+		if (h->size == EMPTY_SIZE) { \
+			EMPTY_SIZE_ERROR(#prefix "_getRootElement"); \
+			return NULL; \
+		} \
+		return h->array[0].data; \
+	}
+
+KEYHEAP_GET_FUNCTIONS(kh, keyheap, int64_t)
+KEYHEAP_GET_FUNCTIONS(dkh, dkeyheap, double)
+
+// Extracting Elements
+
+/**
+ * Estrae l'elemento associato alla chiave massima. Se il puntatore "key" non è NULL, vi viene scritta la chiave.
+ * L'ultimo elemento viene fatto scendere "a buco" a partire dalla radice.
+ */
+#define KEYHEAP_EXTRACT_FUNCTIONS(prefix, heap_type, entry_type, key_type) \
+	void* prefix##_extractRootElement(heap_type* h, key_type* key) { \
+		if (h->size == EMPTY_SIZE) { \
+			EMPTY_SIZE_ERROR(#prefix "_extractRootElement"); \
+			return NULL; \
+		} \
+		entry_type* array = h->array; \
+		void* extracted = array[0].data; \
+		if (key) { \
+			*key = array[0].key; \
+		} \
+		entry_type moving = array[HEAP_TO_ARRAY(h->size)]; \
+		int size = --h->size; \
+		int pos = 1; \
+		int child; \
+		while ((child = pos * 2) <= size) { \
+			if (child < size && array[HEAP_TO_ARRAY(child + 1)].key > array[HEAP_TO_ARRAY(child)].key) { \
+				child++; \
+			} \
+			if (array[HEAP_TO_ARRAY(child)].key <= moving.key) { \
+				break; \
+			} \
+			array[HEAP_TO_ARRAY(pos)] = array[HEAP_TO_ARRAY(child)]; \
+			pos = child; \
+		} \
+		array[HEAP_TO_ARRAY(pos)] = moving; \
+		return extracted; \
+	}
+
+KEYHEAP_EXTRACT_FUNCTIONS(kh, keyheap, keyheap_entry, int64_t)
+KEYHEAP_EXTRACT_FUNCTIONS(dkh, dkeyheap, dkeyheap_entry, double)
@@ -0,0 +1,63 @@
+#ifndef KEYHEAP_H_
+#define KEYHEAP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct keyheap_entry {
+	int64_t key;
+	void* data;
+} keyheap_entry;
+
+typedef struct keyheap {
+	int size;
+	int capacity;
+	keyheap_entry* array;
+} keyheap;
+
+typedef struct dkeyheap_entry {
+	double key;
+	void* data;
+} dkeyheap_entry;
+
+typedef struct dkeyheap {
+	int size;
+	int capacity;
+	dkeyheap_entry* array;
+} dkeyheap;
+
+// Initializing Heap
+keyheap* kh_initHeap(); // OK
+keyheap* kh_initHeapWithCapacity(int cap); // OK
+dkeyheap* dkh_initHeap(); // OK
+dkeyheap* dkh_initHeapWithCapacity(int cap); // OK
+
+// Size
+int kh_getHeapSize(keyheap* h); // OK
+int dkh_getHeapSize(dkeyheap* h); // OK
+
+// Cancelling Heap
+void kh_deleteHeap(keyheap* h); // OK
+void kh_purgeHeap(keyheap* h); // OK
+void dkh_deleteHeap(dkeyheap* h); // OK
+void dkh_purgeHeap(dkeyheap* h); // OK
+
+// Inserting Elements
+void kh_insertElement(keyheap* h, int64_t key, void* new_element); // OK
+void dkh_insertElement(dkeyheap* h, double key, void* new_element); // OK
+
+// Deleting Elements
+void kh_deleteRootElement(keyheap* h); // OK
+void dkh_deleteRootElement(dkeyheap* h); // OK
+
+// Getting Elements
+int64_t kh_getRootKey(keyheap* h); // OK
+void* kh_getRootElement(keyheap* h); // OK
+double dkh_getRootKey(dkeyheap* h); // OK
+void* dkh_getRootElement(dkeyheap* h); // OK
+
+// Extracting Elements
+void* kh_extractRootElement(keyheap* h, int64_t* key); // OK
+void* dkh_extractRootElement(dkeyheap* h, double* key); // OK
+
+#endif
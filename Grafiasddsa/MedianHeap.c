@@ -0,0 +1,320 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "MedianHeap.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef EMPTY_SIZE
+#	define EMPTY_SIZE 0
+#	define EMPTY_SIZE_ERROR(instr) printf("Error: Cannot execute \"%s\" function on empty heap.", instr )
+#endif
+
+#define MEDIAN_QUANTILE 0.5
+#define MINIMUM_TOMBSTONES_FOR_COMPACTION 16
+
+/**
+ * Libreria che permette di mantenere la mediana (o un quantile qualsiasi) di un insieme di elementi
+ * che cambia nel tempo, utilizzando una coppia di binaryheap.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Gli elementi sono divisi in due metà:
+ * - "lower" è un max-heap che contiene gli elementi minori, la cui radice è il quantile cercato;
+ * - "upper" è un min-heap che contiene gli elementi maggiori.
+ * Dopo ogni operazione le due metà vengono ribilanciate in modo che "lower" contenga esattamente
+ * ceil(q * n) elementi (almeno uno, se l'insieme non è vuoto). L'inserimento costa O(log n), mentre
+ * la lettura del quantile costa O(1).
+ *
+ * L'inserimento restituisce un handle, che permette di cancellare l'elemento in un secondo momento (ad esempio
+ * quando esce da una finestra scorrevole). La cancellazione è "pigra": l'handle viene marcato come cancellato,
+ * e rimosso fisicamente solo quando raggiunge la radice del proprio heap. Quando gli handle cancellati diventano
+ * più numerosi di quelli validi, l'heap viene compattato (vedi "bh_extractElementsByCondition").
+ *
+ * <i>NOTA:</i> Finché un handle cancellato non viene rimosso fisicamente, il suo elemento continua ad essere
+ * utilizzato nei confronti, e non deve quindi essere liberato dal chiamante. Se si desidera che sia la struttura
+ * ad occuparsene, è sufficiente cancellarlo con "mh_purgeHandle" invece che con "mh_deleteHandle".
+ *
+ * <i>NOTA:</i> La funzione di comparazione ha lo stesso contratto di "bh_initHeap".
+ */
+
+/*
+typedef struct medianheap_handle {
+	void* data;
+	struct medianheap* owner;
+	bool in_lower;
+	bool deleted;
+	bool purged;
+} medianheap_handle;
+
+typedef struct medianheap {
+	binaryheap* lower;
+	binaryheap* upper;
+	int lower_size;
+	int upper_size;
+	double quantile;
+	int (*comparefunction)(void*, void*);
+} medianheap;
+*/
+
+// Static Utility Functions
+
+/**
+ * Funzione di comparazione degli handle per il max-heap "lower".
+ */
+static int mh_compareLowerHandles(void* h1, void* h2) {
+	medianheap_handle* handle1 = (medianheap_handle*)h1;
+	medianheap_handle* handle2 = (medianheap_handle*)h2;
+	return handle1->owner->comparefunction(handle1->data, handle2->data);
+}
+
+/**
+ * Funzione di comparazione degli handle per il min-heap "upper", ottenuta invertendo la precedente.
+ */
+static int mh_compareUpperHandles(void* h1, void* h2) {
+	return -mh_compareLowerHandles(h1, h2);
+}
+
+static bool mh_isDeletedHandle(void* handle) {
+	return ((medianheap_handle*)handle)->deleted;
+}
+
+/**
+ * Libera la memoria occupata da un handle rimosso fisicamente dalla struttura.
+ * Se l'handle è stato cancellato con "mh_purgeHandle", viene liberato anche il suo elemento.
+ */
+static void mh_freeHandle(medianheap_handle* handle) {
+	if (handle->deleted && handle->purged) {
+		free(handle->data);
+	}
+	free(handle);
+}
+
+/**
+ * Rimuove dalla radice di un heap tutti gli handle cancellati, liberandone la memoria.
+ * Se gli handle cancellati sono diventati troppo numerosi, compatta l'intero heap.
+ */
+static void mh_pruneHeap(binaryheap* bh, int valid_size) {
+	int tombstones = bh_getHeapSize(bh) - valid_size;
+	if (tombstones > valid_size && tombstones > MINIMUM_TOMBSTONES_FOR_COMPACTION) {
+		arraylist* removed = bh_extractElementsByCondition(bh, mh_isDeletedHandle);
+		for (int i = 0; i < removed->size; i++) {
+			mh_freeHandle(removed->array[i]);
+		}
+		al_deleteList(removed);
+		return;
+	}
+	while (bh_getHeapSize(bh) > EMPTY_SIZE && ((medianheap_handle*)bh->al->array[0])->deleted) {
+		mh_freeHandle(bh_extractRootElement(bh));
+	}
+}
+
+/**
+ * Sposta la radice (valida) di un heap nell'altro.
+ */
+static void mh_moveRoot(medianheap* h, binaryheap* from, binaryheap* to) {
+	medianheap_handle* moving = bh_extractRootElement(from);
+	moving->in_lower = (to == h->lower);
+	bh_insertElement(to, moving);
+}
+
+/**
+ * Restituisce il numero di elementi che devono trovarsi nella metà inferiore.
+ */
+static int mh_getTargetLowerSize(medianheap* h) {
+	int size = h->lower_size + h->upper_size;
+	if (size == EMPTY_SIZE) {
+		return 0;
+	}
+	int target = (int)ceil(h->quantile * size);
+	return target < 1 ? 1 : (target > size ? size : target);
+}
+
+/**
+ * Ribilancia le due metà, in modo che la metà inferiore contenga il numero di elementi richiesto dal quantile
+ * e che entrambe le radici siano handle validi.
+ */
+static void mh_rebalance(medianheap* h) {
+	mh_pruneHeap(h->lower, h->lower_size);
+	mh_pruneHeap(h->upper, h->upper_size);
+	int target = mh_getTargetLowerSize(h);
+	while (h->lower_size > target) {
+		mh_moveRoot(h, h->lower, h->upper);
+		h->lower_size--;
+		h->upper_size++;
+		mh_pruneHeap(h->lower, h->lower_size);
+	}
+	while (h->lower_size < target) {
+		mh_moveRoot(h, h->upper, h->lower);
+		h->upper_size--;
+		h->lower_size++;
+		mh_pruneHeap(h->upper, h->upper_size);
+	}
+}
+
+// Initializing Heap
+
+/**
+ * Inizializza una struttura per il mantenimento della mediana.
+ */
+medianheap* mh_initHeap(int (*compare)(void*, void*)) {
+	return mh_initQuantileHeap(compare, MEDIAN_QUANTILE);
+}
+
+/**
+ * Inizializza una struttura per il mantenimento del quantile desiderato, espresso come valore compreso fra 0 e 1.
+ */
+medianheap* mh_initQuantileHeap(int (*compare)(void*, void*), double quantile) {
+	medianheap* new_heap = malloc(sizeof(medianheap));
+	if (!new_heap) {
+		MEMORY_ERROR;
+	}
+	new_heap->lower = bh_initHeap(mh_compareLowerHandles);
+	new_heap->upper = bh_initHeap(mh_compareUpperHandles);
+	new_heap->lower_size = 0;
+	new_heap->upper_size = 0;
+	new_heap->quantile = quantile;
+	new_heap->comparefunction = compare;
+	return new_heap;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di elementi (non cancellati) contenuti nella struttura.
+ */
+int mh_getHeapSize(medianheap* h) {
+	return h->lower_size + h->upper_size;
+}
+
+// Cancelling Heap
+
+/**
+ * Libera la memoria occupata dagli handle di un heap interno, ed eventualmente dagli elementi non cancellati.
+ */
+static void mh_freeHandles(binaryheap* bh, bool purge_data) {
+	for (int i = 0; i < bh_getHeapSize(bh); i++) {
+		medianheap_handle* handle = bh->al->array[i];
+		if (purge_data && !handle->deleted) {
+			free(handle->data);
+		}
+		mh_freeHandle(handle);
+	}
+	bh_deleteHeap(bh);
+}
+
+/**
+ * Elimina la struttura e tutti gli handle, senza eliminare gli elementi.
+ */
+void mh_deleteHeap(medianheap* h) {
+	mh_freeHandles(h->lower, false);
+	mh_freeHandles(h->upper, false);
+	free(h);
+}
+
+/**
+ * Elimina la struttura, tutti gli handle e gli elementi non ancora cancellati.
+ */
+void mh_purgeHeap(medianheap* h) {
+	mh_freeHandles(h->lower, true);
+	mh_freeHandles(h->upper, true);
+	free(h);
+}
+
+// Inserting Elements
+
+/**
+ * Inserisce un elemento nella struttura, restituendo l'handle che permette di cancellarlo.
+ */
+medianheap_handle* mh_insertElement(medianheap* h, void* new_element) {
+	medianheap_handle* handle = malloc(sizeof(medianheap_handle));
+	if (!handle) {
+		MEMORY_ERROR;
+	}
+	handle->data = new_element;
+	handle->owner = h;
+	handle->deleted = false;
+	handle->purged = false;
+	if (h->lower_size == EMPTY_SIZE
+			|| h->comparefunction(new_element, ((medianheap_handle*)h->lower->al->array[0])->data) <= 0) {
+		handle->in_lower = true;
+		bh_insertElement(h->lower, handle);
+		h->lower_size++;
+	} else {
+		handle->in_lower = false;
+		bh_insertElement(h->upper, handle);
+		h->upper_size++;
+	}
+	mh_rebalance(h);
+	return handle;
+}
+
+// Deleting Elements
+
+/**
+ * Cancella dalla struttura l'elemento associato all'handle. L'elemento non viene eliminato dalla memoria,
+ * ma deve rimanere valido finché la struttura non viene eliminata (vedi la nota iniziale).
+ * <i>NOTA:</i> Dopo la chiamata a questa funzione l'handle non deve essere più utilizzato.
+ */
+void mh_deleteHandle(medianheap* h, medianheap_handle* handle) {
+	if (handle->deleted) {
+		return;
+	}
+	handle->deleted = true;
+	if (handle->in_lower) {
+		h->lower_size--;
+	} else {
+		h->upper_size--;
+	}
+	mh_rebalance(h);
+}
+
+// Purging Elements
+
+/**
+ * Cancella dalla struttura l'elemento associato all'handle, delegando alla struttura la sua eliminazione
+ * dalla memoria: l'elemento verrà liberato non appena l'handle sarà rimosso fisicamente.
+ * <i>NOTA:</i> Dopo la chiamata a questa funzione né l'handle né l'elemento devono essere più utilizzati.
+ */
+void mh_purgeHandle(medianheap* h, medianheap_handle* handle) {
+	if (!handle->deleted) {
+		handle->purged = true;
+		mh_deleteHandle(h, handle);
+	}
+}
+
+// Getting Elements
+
+/**
+ * Restituisce l'elemento che corrisponde al quantile della struttura, ossia il ceil(q * n)-esimo elemento
+ * in ordine crescente.
+ */
+void* mh_getQuantileElement(medianheap* h) {
+	if (h->lower_size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("mh_getQuantileElement");
+		return NULL;
+	}
+	return ((medianheap_handle*)h->lower->al->array[0])->data;
+}
+
+/**
+ * Restituisce la mediana degli elementi. Se il numero di elementi è pari, viene restituita la mediana inferiore.
+ * Ha senso solamente per le strutture inizializzate con "mh_initHeap".
+ */
+void* mh_getMedianElement(medianheap* h) {
+	return mh_getQuantileElement(h);
+}
+
+/**
+ * Restituisce la mediana superiore degli elementi, che coincide con la mediana se il numero di elementi è dispari.
+ * Ha senso solamente per le strutture inizializzate con "mh_initHeap".
+ */
+void* mh_getUpperMedianElement(medianheap* h) {
+	if (h->upper_size == EMPTY_SIZE || h->upper_size < h->lower_size) {
+		return mh_getQuantileElement(h);
+	}
+	return ((medianheap_handle*)h->upper->al->array[0])->data;
+}
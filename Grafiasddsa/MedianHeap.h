@@ -0,0 +1,48 @@
+#ifndef MEDIANHEAP_H_
+#define MEDIANHEAP_H_
+
+#include "Heap.h"
+
+typedef struct medianheap_handle {
+	void* data;
+	struct medianheap* owner;
+	bool in_lower;
+	bool deleted;
+	bool purged;
+} medianheap_handle;
+
+typedef struct medianheap {
+	binaryheap* lower;
+	binaryheap* upper;
+	int lower_size;
+	int upper_size;
+	double quantile;
+	int (*comparefunction)(void*, void*);
+} medianheap;
+
+// Initializing Heap
+medianheap* mh_initHeap(int (*compare)(void*, void*)); // OK
+medianheap* mh_initQuantileHeap(int (*compare)(void*, void*), double quantile); // OK
+
+// Size
+int mh_getHeapSize(medianheap* h); // OK
+
+// Cancelling Heap
+void mh_deleteHeap(medianheap* h); // OK
+void mh_purgeHeap(medianheap* h); // OK
+
+// Inserting Elements
+medianheap_handle* mh_insertElement(medianheap* h, void* new_element); // OK
+
+// Deleting Elements
+void mh_deleteHandle(medianheap* h, medianheap_handle* handle); // OK
+
+// Purging Elements
+void mh_purgeHandle(medianheap* h, medianheap_handle* handle); // OK
+
+// Getting Elements
+void* mh_getMedianElement(medianheap* h); // OK
+void* mh_getUpperMedianElement(medianheap* h); // OK
+void* mh_getQuantileElement(medianheap* h); // OK
+
+#endif
@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "MinMaxHeap.h"
+
+#ifndef POSITION_OPERATIONS
+#	define POSITION_OPERATIONS
+#	define ARRAY_TO_HEAP(x) (x + 1)
+#	define HEAP_TO_ARRAY(x) (x - 1)
+#endif
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef EMPTY_SIZE
+#	define EMPTY_SIZE 0
+#	define EMPTY_SIZE_ERROR(instr) printf("Error: Cannot execute \"%s\" function on empty heap.", instr )
+#endif
+
+#define MIN_LEVEL_DIRECTION (-1)
+#define MAX_LEVEL_DIRECTION (1)
+
+/**
+ * Libreria che permette la creazione e gestione di un min-max heap, implementato come arraylist.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Un min-max heap è un albero binario completo in cui i livelli si alternano fra "livelli di minimo" (pari, a partire
+ * dalla radice che si trova al livello 0) e "livelli di massimo" (dispari). Ogni nodo di un livello di minimo
+ * è minore di tutti i suoi discendenti, e ogni nodo di un livello di massimo è maggiore di tutti i suoi discendenti.
+ * Ne consegue che:
+ * - il minimo si trova sempre nella radice;
+ * - il massimo si trova sempre in uno dei due figli della radice.
+ * Entrambi gli estremi sono quindi accessibili in tempo costante, ed estraibili in tempo O(log n).
+ *
+ * <i>NOTA:</i> La funzione di comparazione ha lo stesso contratto di "bh_initHeap".
+ *
+ * <i>NOTA:</i> Come per il binaryheap, la numerazione degli elementi inizia da 1:
+ * dato un nodo [i], il nodo padre avrà indice (int)[i / 2], i nodi figli [i * 2] e [i * 2 + 1].
+ */
+
+/*
+typedef struct minmaxheap {
+	arraylist* al;
+	int (*comparefunction)(void*, void*);
+} minmaxheap;
+*/
+
+// Static Utility Functions
+
+/**
+ * Restituisce true se la posizione (relativa all'heap) appartiene ad un livello di minimo.
+ */
+static bool mmh_isMinLevel(int pos) {
+	return ((31 - __builtin_clz((unsigned int)pos)) & 1) == 0;
+}
+
+/**
+ * Restituisce true se il primo elemento "precede" il secondo nella direzione indicata:
+ * per i livelli di minimo significa essere minore, per i livelli di massimo essere maggiore.
+ */
+static bool mmh_precedes(minmaxheap* h, void* e1, void* e2, int direction) {
+	return direction * h->comparefunction(e1, e2) > 0;
+}
+
+/**
+ * Fa risalire l'elemento alla posizione data lungo i livelli dello stesso tipo (di nonno in nonno).
+ * L'elemento viene scritto una sola volta, nella posizione finale.
+ */
+static void mmh_bubbleUpGrandparents(minmaxheap* h, int pos, int direction) {
+	void** array = h->al->array;
+	void* moving = array[HEAP_TO_ARRAY(pos)];
+	while (pos >= 4 && mmh_precedes(h, moving, array[HEAP_TO_ARRAY(pos / 4)], direction)) {
+		array[HEAP_TO_ARRAY(pos)] = array[HEAP_TO_ARRAY(pos / 4)];
+		pos /= 4;
+	}
+	array[HEAP_TO_ARRAY(pos)] = moving;
+}
+
+/**
+ * Ripristina la proprietà di min-max heap per l'elemento appena inserito in fondo all'array.
+ */
+static void mmh_bubbleUp(minmaxheap* h, int pos) {
+	if (pos == 1) {
+		return;
+	}
+	void** array = h->al->array;
+	int parent = pos / 2;
+	int direction = mmh_isMinLevel(pos) ? MIN_LEVEL_DIRECTION : MAX_LEVEL_DIRECTION;
+	if (mmh_precedes(h, array[HEAP_TO_ARRAY(parent)], array[HEAP_TO_ARRAY(pos)], direction)) {
+		// L'elemento appartiene ai livelli dell'altro tipo: lo scambio con il padre e risalgo da lì
+		void* aux = array[HEAP_TO_ARRAY(parent)];
+		array[HEAP_TO_ARRAY(parent)] = array[HEAP_TO_ARRAY(pos)];
+		array[HEAP_TO_ARRAY(pos)] = aux;
+		mmh_bubbleUpGrandparents(h, parent, -direction);
+	} else {
+		mmh_bubbleUpGrandparents(h, pos, direction);
+	}
+}
+
+/**
+ * Fa scendere l'elemento alla posizione data, confrontandolo con figli e nipoti.
+ * La direzione dipende dal tipo di livello a cui appartiene la posizione di partenza.
+ */
+static void mmh_trickleDown(minmaxheap* h, int pos) {
+	void** array = h->al->array;
+	int size = h->al->size;
+	int direction = mmh_isMinLevel(pos) ? MIN_LEVEL_DIRECTION : MAX_LEVEL_DIRECTION;
+	while (pos * 2 <= size) {
+		// Cerco il "migliore" fra figli e nipoti
+		int best = pos * 2;
+		int candidates[5] = {pos * 2 + 1, pos * 4, pos * 4 + 1, pos * 4 + 2, pos * 4 + 3};
+		for (int i = 0; i < 5 && candidates[i] <= size; i++) {
+			if (mmh_precedes(h, array[HEAP_TO_ARRAY(candidates[i])], array[HEAP_TO_ARRAY(best)], direction)) {
+				best = candidates[i];
+			}
+		}
+		if (!mmh_precedes(h, array[HEAP_TO_ARRAY(best)], array[HEAP_TO_ARRAY(pos)], direction)) {
+			return;
+		}
+		void* aux = array[HEAP_TO_ARRAY(best)];
+		array[HEAP_TO_ARRAY(best)] = array[HEAP_TO_ARRAY(pos)];
+		array[HEAP_TO_ARRAY(pos)] = aux;
+		if (best < pos * 4) {
+			return; // Era un figlio: sotto di lui non ci sono livelli dello stesso tipo da controllare
+		}
+		// Era un nipote: l'elemento sceso potrebbe violare l'ordine con il nuovo padre
+		if (mmh_precedes(h, array[HEAP_TO_ARRAY(best / 2)], array[HEAP_TO_ARRAY(best)], direction)) {
+			aux = array[HEAP_TO_ARRAY(best / 2)];
+			array[HEAP_TO_ARRAY(best / 2)] = array[HEAP_TO_ARRAY(best)];
+			array[HEAP_TO_ARRAY(best)] = aux;
+		}
+		pos = best;
+	}
+}
+
+/**
+ * Restituisce la posizione (relativa all'heap) dell'elemento massimo.
+ */
+static int mmh_getMaximumPosition(minmaxheap* h) {
+	if (h->al->size == 1) {
+		return 1;
+	} else if (h->al->size == 2
+			|| h->comparefunction(h->al->array[HEAP_TO_ARRAY(2)], h->al->array[HEAP_TO_ARRAY(3)]) >= 0) {
+		return 2;
+	} else {
+		return 3;
+	}
+}
+
+/**
+ * Rimuove l'elemento alla posizione data, sostituendolo con l'ultimo elemento dell'array e facendolo scendere.
+ */
+static void* mmh_extractElementAtPosition(minmaxheap* h, int pos) {
+	void* extracted = h->al->array[HEAP_TO_ARRAY(pos)];
+	void* last = al_extractLastElement(h->al);
+	if (pos <= h->al->size) {
+		h->al->array[HEAP_TO_ARRAY(pos)] = last;
+		mmh_trickleDown(h, pos);
+	}
+	return extracted;
+}
+
+// Initializing Heap
+
+/**
+ * Inizializza un min-max heap vuoto e ne restituisce un puntatore.
+ */
+minmaxheap* mmh_initHeap(int (*compare)(void*, void*)) {
+	return mmh_initHeapFromList(compare, al_initList());
+}
+
+/**
+ * Inizializza un min-max heap a partire da una lista di elementi, in tempo lineare.
+ * La lista passata come parametro viene adottata come struttura interna dell'heap, e non deve essere
+ * più utilizzata (né cancellata) dal chiamante.
+ */
+minmaxheap* mmh_initHeapFromList(int (*compare)(void*, void*), arraylist* elements) {
+	minmaxheap* new_heap = malloc(sizeof(minmaxheap));
+	if (!new_heap) {
+		MEMORY_ERROR;
+	}
+	new_heap->al = elements;
+	new_heap->comparefunction = compare;
+	for (int pos = elements->size / 2; pos >= 1; pos--) {
+		mmh_trickleDown(new_heap, pos);
+	}
+	return new_heap;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di elementi contenuti all'interno dell'heap.
+ */
+int mmh_getHeapSize(minmaxheap* h) {
+	return h->al->size;
+}
+
+// Cancelling Heap
+
+/**
+ * Elimina l'heap, ripulendo la memoria occupata dalla lista interna.
+ * Non elimina gli oggetti contenuti in esso.
+ */
+void mmh_deleteHeap(minmaxheap* h) {
+	al_deleteList(h->al);
+	free(h);
+}
+
+/**
+ * Elimina l'heap, ripulendo la memoria occupata dalla lista interna e dagli oggetti contenuti in essa.
+ */
+void mmh_purgeHeap(minmaxheap* h) {
+	al_purgeList(h->al);
+	free(h);
+}
+
+// Inserting Elements
+
+/**
+ * Inserisce un elemento all'interno dell'heap, in tempo O(log n).
+ */
+void mmh_insertElement(minmaxheap* h, void* new_element) {
+	al_insertLastElement(h->al, new_element);
+	mmh_bubbleUp(h, h->al->size);
+}
+
+// Deleting Elements
+
+/**
+ * Cancella l'elemento minimo dall'heap. L'elemento non viene eliminato dalla memoria.
+ */
+void mmh_deleteMinimumElement(minmaxheap* h) {
+	mmh_extractMinimumElement(h);
+}
+
+/**
+ * Cancella l'elemento massimo dall'heap. L'elemento non viene eliminato dalla memoria.
+ */
+void mmh_deleteMaximumElement(minmaxheap* h) {
+	mmh_extractMaximumElement(h);
+}
+
+// Getting Elements
+
+/**
+ * Restituisce l'elemento minimo dell'heap, che si trova nella radice.
+ */
+void* mmh_getMinimumElement(minmaxheap* h) {
+	if (h->al->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("mmh_getMinimumElement");
+		return NULL;
+	}
+	return h->al->array[HEAP_TO_ARRAY(1)];
+}
+
+/**
+ * Restituisce l'elemento massimo dell'heap, che si trova in uno dei due figli della radice.
+ */
+void* mmh_getMaximumElement(minmaxheap* h) {
+	if (h->al->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("mmh_getMaximumElement");
+		return NULL;
+	}
+	return h->al->array[HEAP_TO_ARRAY(mmh_getMaximumPosition(h))];
+}
+
+// Extracting Elements
+
+/**
+ * Estrae l'elemento minimo dell'heap, mantenendo valida la proprietà di min-max heap.
+ */
+void* mmh_extractMinimumElement(minmaxheap* h) {
+	if (h->al->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("mmh_extractMinimumElement");
+		return NULL;
+	}
+	return mmh_extractElementAtPosition(h, 1);
+}
+
+/**
+ * Estrae l'elemento massimo dell'heap, mantenendo valida la proprietà di min-max heap.
+ */
+void* mmh_extractMaximumElement(minmaxheap* h) {
+	if (h->al->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("mmh_extractMaximumElement");
+		return NULL;
+	}
+	return mmh_extractElementAtPosition(h, mmh_getMaximumPosition(h));
+}
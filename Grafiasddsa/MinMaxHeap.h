@@ -0,0 +1,37 @@
+#ifndef MINMAXHEAP_H_
+#define MINMAXHEAP_H_
+
+#include "ArrayList.h"
+
+typedef struct minmaxheap {
+	arraylist* al;
+	int (*comparefunction)(void*, void*);
+} minmaxheap;
+
+// Initializing Heap
+minmaxheap* mmh_initHeap(int (*compare)(void*, void*)); // OK
+minmaxheap* mmh_initHeapFromList(int (*compare)(void*, void*), arraylist* elements); // OK
+
+// Size
+int mmh_getHeapSize(minmaxheap* h); // OK
+
+// Cancelling Heap
+void mmh_deleteHeap(minmaxheap* h); // OK
+void mmh_purgeHeap(minmaxheap* h); // OK
+
+// Inserting Elements
+void mmh_insertElement(minmaxheap* h, void* new_element); // OK
+
+// Deleting Elements
+void mmh_deleteMinimumElement(minmaxheap* h); // OK
+void mmh_deleteMaximumElement(minmaxheap* h); // OK
+
+// Getting Elements
+void* mmh_getMinimumElement(minmaxheap* h); // OK
+void* mmh_getMaximumElement(minmaxheap* h); // OK
+
+// Extracting Elements
+void* mmh_extractMinimumElement(minmaxheap* h); // OK
+void* mmh_extractMaximumElement(minmaxheap* h); // OK
+
+#endif
@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "PairingHeap.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef EMPTY_SIZE
+#	define EMPTY_SIZE 0
+#	define EMPTY_SIZE_ERROR(instr) printf("Error: Cannot execute \"%s\" function on empty heap.", instr )
+#endif
+
+/**
+ * Libreria che permette la creazione e gestione di un pairing heap, ossia di un heap "fondibile" (meldable)
+ * implementato come albero generico di nodi linkati.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * <i>NOTA:</i> come per il binaryheap, la struttura è formalizzata unicamente come max-heap e la funzione
+ * di comparazione ha lo stesso contratto di "bh_initHeap": la radice è l'elemento "maggiore" secondo la relazione.
+ * Per ottenere il min-heap corrispondente, è sufficiente invertire l'output della funzione di comparazione.
+ *
+ * Complessità delle operazioni:
+ * - inserimento, fusione di due heap e promozione di un nodo: O(1);
+ * - estrazione della radice o di un nodo qualsiasi: O(log n) ammortizzato.
+ *
+ * Ogni inserimento restituisce il nodo (handle) che contiene l'elemento: il nodo rimane valido fino alla sua
+ * estrazione o cancellazione, e permette di aggiornare la priorità dell'elemento senza doverlo cercare.
+ *
+ * Ogni nodo mantiene un riferimento al primo figlio, al fratello successivo e al nodo precedente; quest'ultimo
+ * è il padre per il primo figlio di ogni nodo, oppure il fratello precedente per tutti gli altri.
+ */
+
+/*
+typedef struct pairingheap_node {
+	void* data;
+	struct pairingheap_node* child;
+	struct pairingheap_node* sibling;
+	struct pairingheap_node* prev;
+} pairingheap_node;
+
+typedef struct pairingheap {
+	int size;
+	pairingheap_node* root;
+	int (*comparefunction)(void*, void*);
+} pairingheap;
+*/
+
+// Initializing Heap
+
+/**
+ * Inizializza un pairing heap vuoto e ne restituisce un puntatore.
+ */
+pairingheap* ph_initHeap(int (*compare)(void*, void*)) {
+	pairingheap* new_heap = malloc(sizeof(pairingheap));
+	if (!new_heap) {
+		MEMORY_ERROR;
+	}
+	new_heap->size = 0;
+	new_heap->root = NULL;
+	new_heap->comparefunction = compare;
+	return new_heap;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di elementi contenuti all'interno dell'heap.
+ */
+int ph_getHeapSize(pairingheap* h) {
+	return h->size;
+}
+
+// Static Utility Functions
+
+/**
+ * Unisce due alberi (le cui radici non hanno fratelli), rendendo la radice minore il primo figlio della maggiore.
+ * Restituisce la radice dell'albero risultante.
+ */
+static pairingheap_node* ph_linkNodes(pairingheap* h, pairingheap_node* a, pairingheap_node* b) {
+	if (h->comparefunction(b->data, a->data) > 0) {
+		pairingheap_node* aux = a;
+		a = b;
+		b = aux;
+	}
+	b->sibling = a->child;
+	if (a->child) {
+		a->child->prev = b;
+	}
+	b->prev = a;
+	a->child = b;
+	a->sibling = NULL;
+	a->prev = NULL;
+	return a;
+}
+
+/**
+ * Fonde una catena di fratelli in un unico albero secondo la strategia a due passate:
+ * nella prima le radici vengono unite a coppie da sinistra verso destra, nella seconda gli alberi ottenuti
+ * vengono uniti da destra verso sinistra. La funzione è iterativa, e riutilizza il campo "sibling" come pila.
+ */
+static pairingheap_node* ph_mergePairs(pairingheap* h, pairingheap_node* first) {
+	if (!first) {
+		return NULL;
+	}
+	// Prima passata: unisco a coppie, impilando i risultati in ordine inverso
+	pairingheap_node* stack = NULL;
+	while (first) {
+		pairingheap_node* a = first;
+		pairingheap_node* b = first->sibling;
+		if (!b) {
+			a->sibling = stack;
+			stack = a;
+			first = NULL;
+		} else {
+			first = b->sibling;
+			a->sibling = NULL;
+			b->sibling = NULL;
+			pairingheap_node* merged = ph_linkNodes(h, a, b);
+			merged->sibling = stack;
+			stack = merged;
+		}
+	}
+	// Seconda passata: unisco gli alberi da destra verso sinistra
+	pairingheap_node* result = stack;
+	stack = stack->sibling;
+	result->sibling = NULL;
+	while (stack) {
+		pairingheap_node* next = stack->sibling;
+		stack->sibling = NULL;
+		result = ph_linkNodes(h, result, stack);
+		stack = next;
+	}
+	result->prev = NULL;
+	return result;
+}
+
+/**
+ * Stacca un nodo (diverso dalla radice) dal suo albero, insieme al suo sotto-albero.
+ */
+static void ph_detachNode(pairingheap_node* node) {
+	if (node->prev->child == node) {
+		node->prev->child = node->sibling;		// Sono il primo figlio: "prev" è mio padre
+	} else {
+		node->prev->sibling = node->sibling;	// "prev" è mio fratello
+	}
+	if (node->sibling) {
+		node->sibling->prev = node->prev;
+	}
+	node->prev = NULL;
+	node->sibling = NULL;
+}
+
+/**
+ * Libera la memoria occupata da tutti i nodi dell'heap, ed eventualmente dai loro contenuti.
+ * La visita è iterativa: ogni nodo visitato accoda la catena dei suoi figli alla catena ancora da visitare.
+ */
+static void ph_freeNodes(pairingheap* h, bool purge_data) {
+	pairingheap_node* pending = h->root;
+	while (pending) {
+		pairingheap_node* node = pending;
+		pending = node->sibling;
+		if (node->child) {
+			pairingheap_node* last_child = node->child;
+			while (last_child->sibling) {
+				last_child = last_child->sibling;
+			}
+			last_child->sibling = pending;
+			pending = node->child;
+		}
+		if (purge_data) {
+			free(node->data);
+		}
+		free(node);
+	}
+	h->root = NULL;
+	h->size = 0;
+}
+
+// Cancelling Heap
+
+/**
+ * Elimina l'heap, ripulendo la memoria occupata dai nodi interni.
+ *
+ * <i>NOTA</i>: Non elimina gli oggetti contenuti in esso. In alternativa, è possibile chiamare
+ * "ph_purgeHeap()" che ripulisce anche la memoria occupata dagli elementi.
+ */
+void ph_deleteHeap(pairingheap* h) {
+	ph_freeNodes(h, false);
+	free(h);
+}
+
+/**
+ * Elimina l'heap, ripulendo la memoria occupata dai nodi interni e dagli oggetti contenuti in essi.
+ */
+void ph_purgeHeap(pairingheap* h) {
+	ph_freeNodes(h, true);
+	free(h);
+}
+
+// Inserting Elements
+
+/**
+ * Inserisce un elemento all'interno dell'heap in tempo costante.
+ * Restituisce il nodo che contiene l'elemento, utilizzabile in seguito con "ph_promoteNode", "ph_updateNode",
+ * "ph_extractNode" e "ph_deleteNode".
+ */
+pairingheap_node* ph_insertElement(pairingheap* h, void* new_element) {
+	pairingheap_node* new_node = malloc(sizeof(pairingheap_node));
+	if (!new_node) {
+		MEMORY_ERROR;
+	}
+	new_node->data = new_element;
+	new_node->child = NULL;
+	new_node->sibling = NULL;
+	new_node->prev = NULL;
+	h->root = h->root ? ph_linkNodes(h, h->root, new_node) : new_node;
+	h->size++;
+	return new_node;
+}
+
+// Merging Heaps
+
+/**
+ * Fonde il secondo heap all'interno del primo in tempo costante.
+ * Il secondo heap viene eliminato, mentre i suoi nodi (e quindi i relativi handle) rimangono validi all'interno del primo.
+ *
+ * <i>NOTA:</i> Pre-condizione per l'utilizzo di questa funzione è che i due heap utilizzino la stessa funzione di comparazione.
+ */
+void ph_mergeHeaps(pairingheap* h1, pairingheap* h2) {
+	if (h1 != h2) {
+		if (h2->root) {
+			h1->root = h1->root ? ph_linkNodes(h1, h1->root, h2->root) : h2->root;
+			h1->size += h2->size;
+		}
+		free(h2);
+	}
+}
+
+// Deleting Elements
+
+/**
+ * Cancella la radice dell'heap e risistema i nodi restanti.
+ * L'elemento non viene eliminato dalla memoria.
+ */
+void ph_deleteRootElement(pairingheap* h) {
+	ph_extractRootElement(h);
+}
+
+/**
+ * Cancella dall'heap il nodo passato come parametro.
+ * L'elemento contenuto non viene eliminato dalla memoria, mentre il nodo non è più utilizzabile.
+ */
+void ph_deleteNode(pairingheap* h, pairingheap_node* node) {
+	ph_extractNode(h, node);
+}
+
+// Purging Elements
+
+/**
+ * Elimina dall'heap e dalla memoria del programma l'elemento radice.
+ */
+void ph_purgeRootElement(pairingheap* h) {
+	free(ph_extractRootElement(h));
+}
+
+// Getting Elements
+
+/**
+ * Restituisce l'elemento radice dell'heap, ossia il "maggiore" secondo la funzione comparatrice.
+ */
+void* ph_getRootElement(pairingheap* h) {
+	if (h->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("ph_getRootElement");
+		return NULL;
+	}
+	return h->root->data;
+}
+
+// Extracting Elements
+
+/**
+ * Estrae l'elemento radice dell'heap, fondendo i suoi figli in un unico albero.
+ * Il nodo che conteneva l'elemento viene liberato.
+ */
+void* ph_extractRootElement(pairingheap* h) {
+	if (h->size == EMPTY_SIZE) {
+		EMPTY_SIZE_ERROR("ph_extractRootElement");
+		return NULL;
+	}
+	pairingheap_node* old_root = h->root;
+	void* data = old_root->data;
+	h->root = ph_mergePairs(h, old_root->child);
+	h->size--;
+	free(old_root);
+	return data;
+}
+
+/**
+ * Estrae dall'heap un nodo qualsiasi, restituendone il contenuto.
+ * Il sotto-albero del nodo viene fuso e ricollegato alla radice; il nodo viene liberato.
+ */
+void* ph_extractNode(pairingheap* h, pairingheap_node* node) {
+	if (node == h->root) {
+		return ph_extractRootElement(h);
+	}
+	void* data = node->data;
+	ph_detachNode(node);
+	pairingheap_node* subtree = ph_mergePairs(h, node->child);
+	if (subtree) {
+		h->root = ph_linkNodes(h, h->root, subtree);
+	}
+	h->size--;
+	free(node);
+	return data;
+}
+
+// Updating Elements
+
+/**
+ * Notifica all'heap che l'elemento contenuto nel nodo è stato modificato in modo da risultare "maggiore" di prima
+ * (l'equivalente del "decrease-key" di un min-heap). Il nodo viene staccato dal padre e ricollegato alla radice
+ * in tempo costante.
+ *
+ * <i>NOTA:</i> se l'elemento è diventato "minore", è necessario utilizzare "ph_updateNode".
+ */
+void ph_promoteNode(pairingheap* h, pairingheap_node* node) {
+	if (node != h->root) {
+		ph_detachNode(node);
+		h->root = ph_linkNodes(h, h->root, node);
+	}
+}
+
+/**
+ * Notifica all'heap che l'elemento contenuto nel nodo è stato modificato in modo arbitrario.
+ * Il nodo viene rimosso e reinserito (mantenendo valido l'handle), con costo O(log n) ammortizzato.
+ */
+void ph_updateNode(pairingheap* h, pairingheap_node* node) {
+	pairingheap_node* children = node->child;
+	node->child = NULL;
+	if (node == h->root) {
+		h->root = ph_mergePairs(h, children);
+	} else {
+		ph_detachNode(node);
+		pairingheap_node* subtree = ph_mergePairs(h, children);
+		if (subtree) {
+			h->root = ph_linkNodes(h, h->root, subtree);
+		}
+	}
+	h->root = h->root ? ph_linkNodes(h, h->root, node) : node;
+}
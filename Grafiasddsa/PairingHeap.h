@@ -0,0 +1,53 @@
+#ifndef PAIRINGHEAP_H_
+#define PAIRINGHEAP_H_
+
+#include <stdbool.h>
+
+typedef struct pairingheap_node {
+	void* data;
+	struct pairingheap_node* child;
+	struct pairingheap_node* sibling;
+	struct pairingheap_node* prev;
+} pairingheap_node;
+
+typedef struct pairingheap {
+	int size;
+	pairingheap_node* root;
+	int (*comparefunction)(void*, void*);
+} pairingheap;
+
+// Initializing Heap
+pairingheap* ph_initHeap(int (*compare)(void*, void*)); // OK
+
+// Size
+int ph_getHeapSize(pairingheap* h); // OK
+
+// Cancelling Heap
+void ph_deleteHeap(pairingheap* h); // OK
+void ph_purgeHeap(pairingheap* h); // OK
+
+// Inserting Elements
+pairingheap_node* ph_insertElement(pairingheap* h, void* new_element); // OK
+
+// Merging Heaps
+void ph_mergeHeaps(pairingheap* h1, pairingheap* h2); // OK
+
+// Deleting Elements
+void ph_deleteRootElement(pairingheap* h); // OK
+void ph_deleteNode(pairingheap* h, pairingheap_node* node); // OK
+
+// Purging Elements
+void ph_purgeRootElement(pairingheap* h); // OK
+
+// Getting Elements
+void* ph_getRootElement(pairingheap* h); // OK
+
+// Extracting Elements
+void* ph_extractRootElement(pairingheap* h); // OK
+void* ph_extractNode(pairingheap* h, pairingheap_node* node); // OK
+
+// Updating Elements
+void ph_promoteNode(pairingheap* h, pairingheap_node* node); // OK
+void ph_updateNode(pairingheap* h, pairingheap_node* node); // OK
+
+#endif
@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "ThreadPool.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+/**
+ * Libreria che implementa un gruppo di thread ("pool") condiviso dagli algoritmi paralleli sui grafi.
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Gli algoritmi procedono per passi: ad ogni passo la stessa funzione viene eseguita da tutti i thread del gruppo,
+ * e il passo termina quando tutti i thread l'hanno completata. Il thread chiamante partecipa come primo lavoratore,
+ * per cui un gruppo di n thread ne crea solamente (n - 1).
+ *
+ * I thread vengono creati una volta sola, all'inizializzazione del gruppo, e restano in attesa fra un passo e il
+ * successivo: gli algoritmi che eseguono molti passi brevi (come i passi leggeri del delta-stepping) pagano così solo
+ * il risveglio dei thread, e non la loro creazione. L'inizio e la fine di ogni passo sono sincronizzati con un mutex
+ * e due variabili condition: il chiamante incrementa il contatore dei passi ("generation") e risveglia i lavoratori,
+ * poi attende che il numero di lavoratori ancora attivi ("running") si azzeri. Non viene usato "pthread_barrier_t",
+ * che è un'estensione opzionale di POSIX, assente ad esempio su macOS.
+ *
+ * Ogni lavoratore riceve come argomento un elemento di un array fornito dal chiamante (ad esempio lo stato privato di
+ * ogni thread), oppure, se la dimensione degli elementi è nulla, lo stesso puntatore per tutti.
+ * Per distribuire il lavoro dinamicamente, ogni passo è associato ad un intervallo di elementi da 0 a "limit": i
+ * lavoratori se ne spartiscono blocchi consecutivi di dimensione scelta, tramite un cursore incrementato atomicamente.
+ */
+
+/*
+typedef struct tp_thread {
+	struct threadpool* pool;
+	pthread_t thread;
+	int index;
+} tp_thread;
+
+typedef struct threadpool {
+	int threads_number;
+	tp_thread* threads;
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	pthread_cond_t finish;
+	long generation;
+	int running;
+	bool stopping;
+	void* (*step)(void*);
+	char* arguments;
+	size_t argument_size;
+	int limit;
+	int cursor;
+} threadpool;
+*/
+
+// Static Utility Functions
+
+/**
+ * Ciclo di un thread del gruppo: attende l'inizio di un nuovo passo, esegue la funzione sul proprio argomento e
+ * segnala la fine, fino all'eliminazione del gruppo.
+ */
+static void* tp_workerLoop(void* arg) {
+	tp_thread* t = (tp_thread*)arg;
+	threadpool* p = t->pool;
+	long generation = 0;
+	pthread_mutex_lock(&p->lock);
+	while (true) {
+		while (p->generation == generation && !p->stopping) {
+			pthread_cond_wait(&p->start, &p->lock);
+		}
+		if (p->stopping) {
+			break;
+		}
+		generation = p->generation;
+		void* (*step)(void*) = p->step;
+		void* argument = p->arguments + t->index * p->argument_size;
+		pthread_mutex_unlock(&p->lock);
+		step(argument);
+		pthread_mutex_lock(&p->lock);
+		if (--p->running == 0) {
+			pthread_cond_signal(&p->finish);
+		}
+	}
+	pthread_mutex_unlock(&p->lock);
+	return NULL;
+}
+
+// Initializing Thread Pool
+
+/**
+ * Restituisce il numero di thread da utilizzare: quello dato se positivo, altrimenti uno per processore.
+ */
+int tp_getThreadsNumber(int threads_number) {
+	if (threads_number <= 0) {
+		long processors = sysconf(_SC_NPROCESSORS_ONLN);
+		threads_number = processors > 0 ? (int)processors : 1;
+	}
+	return threads_number;
+}
+
+/**
+ * Inizializza un gruppo con il numero di thread dato (se non positivo, uno per processore), creando i thread.
+ */
+threadpool* tp_initThreadPool(int threads_number) {
+	threadpool* new_pool = malloc(sizeof(threadpool));
+	if (!new_pool) {
+		MEMORY_ERROR;
+	}
+	new_pool->threads_number = tp_getThreadsNumber(threads_number);
+	new_pool->threads = malloc(new_pool->threads_number * sizeof(tp_thread));
+	if (!new_pool->threads) {
+		MEMORY_ERROR;
+	}
+	pthread_mutex_init(&new_pool->lock, NULL);
+	pthread_cond_init(&new_pool->start, NULL);
+	pthread_cond_init(&new_pool->finish, NULL);
+	new_pool->generation = 0;
+	new_pool->running = 0;
+	new_pool->stopping = false;
+	new_pool->step = NULL;
+	new_pool->arguments = NULL;
+	new_pool->argument_size = 0;
+	new_pool->limit = 0;
+	new_pool->cursor = 0;
+	for (int i = 1; i < new_pool->threads_number; i++) {
+		new_pool->threads[i].pool = new_pool;
+		new_pool->threads[i].index = i;
+		if (pthread_create(&new_pool->threads[i].thread, NULL, tp_workerLoop, &new_pool->threads[i]) != 0) {
+			printf("Error: Cannot create thread.\n");
+			exit(1);
+		}
+	}
+	return new_pool;
+}
+
+// Cancelling Thread Pool
+
+/**
+ * Elimina il gruppo, attendendo la terminazione dei thread. Non deve essere invocata durante un passo.
+ */
+void tp_deleteThreadPool(threadpool* p) {
+	pthread_mutex_lock(&p->lock);
+	p->stopping = true;
+	pthread_cond_broadcast(&p->start);
+	pthread_mutex_unlock(&p->lock);
+	for (int i = 1; i < p->threads_number; i++) {
+		pthread_join(p->threads[i].thread, NULL);
+	}
+	pthread_mutex_destroy(&p->lock);
+	pthread_cond_destroy(&p->start);
+	pthread_cond_destroy(&p->finish);
+	free(p->threads);
+	free(p);
+}
+
+// Running Steps
+
+/**
+ * Esegue la funzione "step" su tutti i thread del gruppo, e ritorna quando tutti l'hanno completata.
+ * Il lavoratore i-esimo riceve l'elemento i-esimo dell'array "arguments", di elementi grandi "argument_size" byte;
+ * se "argument_size" è nullo, tutti i lavoratori ricevono "arguments". Il cursore viene riportato a 0, e i blocchi
+ * restituiti da "tp_nextChunk" durante il passo sono compresi fra 0 e "limit".
+ */
+void tp_runStep(threadpool* p, void* (*step)(void*), void* arguments, size_t argument_size, int limit) {
+	pthread_mutex_lock(&p->lock);
+	p->step = step;
+	p->arguments = arguments;
+	p->argument_size = argument_size;
+	p->limit = limit;
+	p->cursor = 0;
+	if (p->threads_number > 1) {
+		p->running = p->threads_number - 1;
+		p->generation++;
+		pthread_cond_broadcast(&p->start);
+	}
+	pthread_mutex_unlock(&p->lock);
+	step(p->arguments);
+	pthread_mutex_lock(&p->lock);
+	while (p->running > 0) {
+		pthread_cond_wait(&p->finish, &p->lock);
+	}
+	pthread_mutex_unlock(&p->lock);
+}
+
+/**
+ * Restituisce nell'intervallo [begin, end) il prossimo blocco di al più "chunk" elementi del passo corrente, oppure
+ * false se sono terminati. Può essere invocata da tutti i lavoratori contemporaneamente.
+ */
+bool tp_nextChunk(threadpool* p, int chunk, int* begin, int* end) {
+	*begin = __atomic_fetch_add(&p->cursor, chunk, __ATOMIC_RELAXED);
+	if (*begin >= p->limit) {
+		return false;
+	}
+	*end = *begin + chunk < p->limit ? *begin + chunk : p->limit;
+	return true;
+}
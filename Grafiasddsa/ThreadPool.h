@@ -0,0 +1,41 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+typedef struct tp_thread {
+	struct threadpool* pool;
+	pthread_t thread;
+	int index;
+} tp_thread;
+
+typedef struct threadpool {
+	int threads_number;
+	tp_thread* threads;
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	pthread_cond_t finish;
+	long generation;
+	int running;
+	bool stopping;
+	void* (*step)(void*);
+	char* arguments;
+	size_t argument_size;
+	int limit;
+	int cursor;
+} threadpool;
+
+// Initializing Thread Pool
+int tp_getThreadsNumber(int threads_number); // OK
+threadpool* tp_initThreadPool(int threads_number); // OK
+
+// Cancelling Thread Pool
+void tp_deleteThreadPool(threadpool* p); // OK
+
+// Running Steps
+void tp_runStep(threadpool* p, void* (*step)(void*), void* arguments, size_t argument_size, int limit); // OK
+bool tp_nextChunk(threadpool* p, int chunk, int* begin, int* end); // OK
+
+#endif
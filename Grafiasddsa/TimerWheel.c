@@ -0,0 +1,481 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "TimerWheel.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#define TIMERWHEEL_SLOT_MASK (TIMERWHEEL_SLOTS - 1)
+#define TIMERWHEEL_LEVEL_SHIFT(level) (TIMERWHEEL_SLOT_BITS * (level))
+#define TIMERWHEEL_MAX_DELAY ((1UL << TIMERWHEEL_LEVEL_SHIFT(TIMERWHEEL_LEVELS)) - 1)
+
+/**
+ * Libreria che implementa un timing wheel gerarchico, per la gestione di un gran numero di scadenze (timeout).
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Il tempo è misurato in "tick" discreti. La struttura è formata da TIMERWHEEL_LEVELS ruote, ciascuna composta da
+ * TIMERWHEEL_SLOTS slot; ogni slot è una blinked_list di timer. La ruota di livello L copre gli intervalli di
+ * TIMERWHEEL_SLOTS^L tick: un timer viene inserito nel livello più basso in grado di contenere il suo ritardo e,
+ * quando la ruota del livello inferiore compie un giro completo, i timer dello slot corrispondente del livello
+ * superiore vengono ridistribuiti ("cascata") nei livelli inferiori.
+ *
+ * Complessità delle operazioni:
+ * - programmazione e cancellazione di un timer: O(1), senza ricerche né confronti;
+ * - avanzamento di un tick: O(1) ammortizzato, più il costo delle scadenze effettivamente avvenute.
+ * Rispetto ad un heap di scadenze, la struttura è particolarmente conveniente quando la maggior parte dei timer
+ * viene cancellata prima di scadere.
+ *
+ * Ogni timer contiene al suo interno il nodo della blinked_list (il cui campo "data" punta all'elemento dell'utente),
+ * quindi è sufficiente una sola allocazione per timer.
+ *
+ * I timer che scadono in un tick vengono spostati nella lista "expiring" prima di chiamare la procedura di scadenza:
+ * la procedura può quindi cancellare anche un altro timer in scadenza nello stesso tick (ad esempio un timeout
+ * accoppiato), che viene semplicemente rimosso da quella lista e non scade.
+ *
+ * <i>NOTA:</i> I ritardi superiori a TIMERWHEEL_MAX_DELAY vengono gestiti mantenendo il timer nell'ultimo livello
+ * e ricollocandolo ad ogni giro di quest'ultimo, fino al raggiungimento della scadenza.
+ */
+
+/*
+typedef struct timerwheel_timer {
+	blinked_list_node node;
+	unsigned long expiration;
+	blinked_list* slot;
+} timerwheel_timer;
+
+typedef struct timerwheel {
+	unsigned long current_tick;
+	int size;
+	int level_sizes[TIMERWHEEL_LEVELS];
+	blinked_list slots[TIMERWHEEL_LEVELS][TIMERWHEEL_SLOTS];
+	blinked_list expiring;
+} timerwheel;
+*/
+
+// Static Utility Functions
+
+/**
+ * Restituisce il livello a cui appartiene uno slot.
+ */
+static int tw_getSlotLevel(timerwheel* w, blinked_list* slot) {
+	return (int)((slot - &w->slots[0][0]) / TIMERWHEEL_SLOTS);
+}
+
+/**
+ * Aggiunge un timer in coda allo slot indicato.
+ */
+static void tw_appendTimer(timerwheel* w, blinked_list* slot, timerwheel_timer* timer) {
+	blinked_list_node* node = &timer->node;
+	node->next = NULL;
+	node->prev = slot->tail;
+	if (slot->tail) {
+		slot->tail->next = node;
+	} else {
+		slot->head = node;
+	}
+	slot->tail = node;
+	slot->size++;
+	w->level_sizes[tw_getSlotLevel(w, slot)]++;
+	timer->slot = slot;
+}
+
+/**
+ * Stacca un timer dallo slot (o dalla lista dei timer in scadenza) in cui si trova, in tempo costante.
+ */
+static void tw_unlinkTimer(timerwheel* w, timerwheel_timer* timer) {
+	blinked_list* slot = timer->slot;
+	blinked_list_node* node = &timer->node;
+	if (node->prev) {
+		node->prev->next = node->next;
+	} else {
+		slot->head = node->next;
+	}
+	if (node->next) {
+		node->next->prev = node->prev;
+	} else {
+		slot->tail = node->prev;
+	}
+	slot->size--;
+	if (slot != &w->expiring) {
+		w->level_sizes[tw_getSlotLevel(w, slot)]--;
+	}
+	timer->slot = NULL;
+}
+
+/**
+ * Stacca tutti i timer di uno slot, restituendo il primo nodo della catena. I timer della catena non appartengono
+ * più ad alcuno slot.
+ */
+static blinked_list_node* tw_detachSlot(timerwheel* w, blinked_list* slot) {
+	blinked_list_node* first = slot->head;
+	w->level_sizes[tw_getSlotLevel(w, slot)] -= slot->size;
+	for (blinked_list_node* iterator = first; iterator; iterator = iterator->next) {
+		((timerwheel_timer*)iterator)->slot = NULL;
+	}
+	slot->head = NULL;
+	slot->tail = NULL;
+	slot->size = 0;
+	return first;
+}
+
+/**
+ * Colloca un timer nello slot opportuno, a seconda della distanza fra la sua scadenza e il tick corrente.
+ */
+static void tw_placeTimer(timerwheel* w, timerwheel_timer* timer) {
+	unsigned long delta = timer->expiration - w->current_tick;
+	unsigned long expiration = timer->expiration;
+	if (delta > TIMERWHEEL_MAX_DELAY) {
+		expiration = w->current_tick + TIMERWHEEL_MAX_DELAY;		// Verrà ricollocato al prossimo giro
+		delta = TIMERWHEEL_MAX_DELAY;
+	}
+	int level = 0;
+	while (level < TIMERWHEEL_LEVELS - 1 && delta >= (1UL << TIMERWHEEL_LEVEL_SHIFT(level + 1))) {
+		level++;
+	}
+	int index = (int)((expiration >> TIMERWHEEL_LEVEL_SHIFT(level)) & TIMERWHEEL_SLOT_MASK);
+	tw_appendTimer(w, &w->slots[level][index], timer);
+}
+
+/**
+ * Ridistribuisce nei livelli inferiori i timer dello slot corrente del livello indicato.
+ */
+static void tw_cascadeLevel(timerwheel* w, int level) {
+	int index = (int)((w->current_tick >> TIMERWHEEL_LEVEL_SHIFT(level)) & TIMERWHEEL_SLOT_MASK);
+	blinked_list_node* iterator = tw_detachSlot(w, &w->slots[level][index]);
+	while (iterator) {
+		timerwheel_timer* timer = (timerwheel_timer*)iterator;
+		iterator = iterator->next;
+		tw_placeTimer(w, timer);
+	}
+}
+
+/**
+ * Avanza di un singolo tick: esegue le cascate necessarie e fa scadere i timer dello slot corrente del primo livello.
+ * Restituisce il numero di timer scaduti.
+ */
+static int tw_processTick(timerwheel* w, void (*expire)(void*)) {
+	w->current_tick++;
+	for (int level = 1; level < TIMERWHEEL_LEVELS; level++) {
+		if ((w->current_tick & ((1UL << TIMERWHEEL_LEVEL_SHIFT(level)) - 1)) != 0) {
+			break;	// Il livello inferiore non ha completato un giro
+		}
+		tw_cascadeLevel(w, level);
+	}
+	// Lo slot corrente diventa la lista dei timer in scadenza, che vengono estratti uno alla volta
+	int index = (int)(w->current_tick & TIMERWHEEL_SLOT_MASK);
+	blinked_list* slot = &w->slots[0][index];
+	w->level_sizes[0] -= slot->size;
+	w->expiring = *slot;
+	for (blinked_list_node* iterator = w->expiring.head; iterator; iterator = iterator->next) {
+		((timerwheel_timer*)iterator)->slot = &w->expiring;
+	}
+	slot->head = NULL;
+	slot->tail = NULL;
+	slot->size = 0;
+	int expired = 0;
+	while (w->expiring.head) {
+		timerwheel_timer* timer = (timerwheel_timer*)w->expiring.head;
+		void* element = timer->node.data;
+		tw_unlinkTimer(w, timer);
+		free(timer);
+		w->size--;
+		expired++;
+		if (expire) {
+			expire(element);	// Il timer è già stato liberato: la procedura può programmare o cancellare timer
+		}
+	}
+	return expired;
+}
+
+// Initializing Wheel
+
+/**
+ * Inizializza un timing wheel vuoto, il cui tempo corrente è il tick indicato.
+ */
+timerwheel* tw_initWheel(unsigned long start_tick) {
+	timerwheel* new_wheel = malloc(sizeof(timerwheel));
+	if (!new_wheel) {
+		MEMORY_ERROR;
+	}
+	new_wheel->current_tick = start_tick;
+	new_wheel->size = 0;
+	for (int level = 0; level < TIMERWHEEL_LEVELS; level++) {
+		new_wheel->level_sizes[level] = 0;
+		for (int i = 0; i < TIMERWHEEL_SLOTS; i++) {
+			new_wheel->slots[level][i].size = 0;
+			new_wheel->slots[level][i].head = NULL;
+			new_wheel->slots[level][i].tail = NULL;
+		}
+	}
+	new_wheel->expiring.size = 0;
+	new_wheel->expiring.head = NULL;
+	new_wheel->expiring.tail = NULL;
+	return new_wheel;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di timer programmati e non ancora scaduti o cancellati.
+ */
+int tw_getWheelSize(timerwheel* w) {
+	return w->size;
+}
+
+// Cancelling Wheel
+
+/**
+ * Libera la memoria occupata da tutti i timer, ed eventualmente dagli elementi associati.
+ */
+static void tw_freeWheel(timerwheel* w, bool purge) {
+	for (int level = 0; level < TIMERWHEEL_LEVELS; level++) {
+		for (int i = 0; i < TIMERWHEEL_SLOTS; i++) {
+			blinked_list_node* iterator = tw_detachSlot(w, &w->slots[level][i]);
+			while (iterator) {
+				blinked_list_node* next = iterator->next;
+				if (purge) {
+					free(iterator->data);
+				}
+				free(iterator);
+				iterator = next;
+			}
+		}
+	}
+	free(w);
+}
+
+/**
+ * Elimina il timing wheel e tutti i timer ancora programmati, senza eliminare gli elementi associati.
+ */
+void tw_deleteWheel(timerwheel* w) {
+	tw_freeWheel(w, false);
+}
+
+/**
+ * Elimina il timing wheel, tutti i timer ancora programmati e gli elementi associati.
+ */
+void tw_purgeWheel(timerwheel* w) {
+	tw_freeWheel(w, true);
+}
+
+// Scheduling Elements
+
+/**
+ * Programma la scadenza di un elemento dopo il numero di tick indicato (almeno uno).
+ * Restituisce il timer, che rimane valido fino alla sua scadenza o cancellazione.
+ */
+timerwheel_timer* tw_scheduleElement(timerwheel* w, void* element, unsigned long delay) {
+	timerwheel_timer* timer = malloc(sizeof(timerwheel_timer));
+	if (!timer) {
+		MEMORY_ERROR;
+	}
+	timer->node.data = element;
+	timer->expiration = w->current_tick + (delay > 0 ? delay : 1);
+	tw_placeTimer(w, timer);
+	w->size++;
+	return timer;
+}
+
+/**
+ * Cancella un timer non ancora scaduto, in tempo costante, restituendo l'elemento associato.
+ * Il timer viene liberato e non deve essere più utilizzato. La cancellazione è ammessa anche all'interno della
+ * procedura di scadenza, per i timer che non sono ancora scaduti (compresi quelli dello stesso tick).
+ */
+void* tw_cancelTimer(timerwheel* w, timerwheel_timer* timer) {
+	void* element = timer->node.data;
+	tw_unlinkTimer(w, timer);
+	free(timer);
+	w->size--;
+	return element;
+}
+
+// Advancing Time
+
+/**
+ * Fa avanzare il tempo del numero di tick indicato, chiamando la procedura "expire" (se non NULL) sull'elemento
+ * di ogni timer scaduto. I timer scadono in ordine di tick; all'interno dello stesso tick, in ordine di programmazione
+ * (a meno di ricollocazioni dovute alle cascate). Restituisce il numero di timer scaduti.
+ *
+ * <i>NOTA:</i> Se i livelli inferiori sono vuoti, nessun timer può scadere prima della prossima cascata del primo
+ * livello non vuoto: i tick intermedi vengono quindi saltati in blocco.
+ */
+int tw_advanceTicks(timerwheel* w, unsigned long ticks, void (*expire)(void*)) {
+	int expired = 0;
+	unsigned long target = w->current_tick + ticks;
+	while (w->current_tick != target) {
+		if (w->size == 0) {
+			w->current_tick = target;	// Nessun timer da gestire: salto direttamente alla fine
+			break;
+		}
+		int level = 0;
+		while (w->level_sizes[level] == 0) {
+			level++;
+		}
+		if (level > 0) {
+			// Salto al tick che precede la prossima cascata del livello
+			unsigned long skip_to = w->current_tick | ((1UL << TIMERWHEEL_LEVEL_SHIFT(level)) - 1);
+			if (skip_to - w->current_tick >= target - w->current_tick) {
+				w->current_tick = target;
+				break;
+			}
+			w->current_tick = skip_to;
+		}
+		expired += tw_processTick(w, expire);
+	}
+	return expired;
+}
+
+///////////////////////// MAIN //////////////////////////////
+
+// Confronto con l'heap di scadenze, compilato solamente con l'opzione -DTIMERWHEEL_BENCHMARK.
+// Heap.c contiene a sua volta un main, che va rinominato in fase di compilazione:
+//   gcc -O2 -c -Dmain=heap_main Heap.c
+//   gcc -O2 -DTIMERWHEEL_BENCHMARK TimerWheel.c Heap.o ArrayList.c -lm
+#ifdef TIMERWHEEL_BENCHMARK
+
+#include <time.h>
+
+#include "Heap.h"
+
+#define BENCHMARK_ROUNDS 50
+#define BENCHMARK_TIMERS 20000
+#define BENCHMARK_MAX_DELAY 4096
+#define BENCHMARK_CANCELLED_PERCENTAGE 95
+
+typedef struct benchmark_timeout {
+	unsigned long expiration;
+	bool cancelled;
+	int position;
+} benchmark_timeout;
+
+static long benchmark_expired = 0;
+
+/**
+ * Confronta due scadenze in modo che l'heap (max-heap) abbia in radice la scadenza più vicina.
+ */
+static int compareTimeouts(void* first, void* second) {
+	unsigned long a = ((benchmark_timeout*)first)->expiration;
+	unsigned long b = ((benchmark_timeout*)second)->expiration;
+	return (a < b) - (a > b);
+}
+
+static void markTimeout(void* timeout) {
+	((benchmark_timeout*)timeout)->cancelled = true;
+}
+
+static bool isMarkedTimeout(void* timeout) {
+	return ((benchmark_timeout*)timeout)->cancelled;
+}
+
+static void unmarkTimeout(void* timeout) {
+	((benchmark_timeout*)timeout)->cancelled = false;
+}
+
+static void setTimeoutPosition(void* timeout, int position) {
+	((benchmark_timeout*)timeout)->position = position;
+}
+
+static int getTimeoutPosition(void* timeout) {
+	return ((benchmark_timeout*)timeout)->position;
+}
+
+static void expireTimeout(void* timeout) {
+	(void)timeout;
+	benchmark_expired++;
+}
+
+/**
+ * Restituisce i secondi di CPU trascorsi dall'istante dato.
+ */
+static double getElapsedSeconds(clock_t start) {
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Percorso con l'heap: le scadenze vengono inserite, la maggior parte viene cancellata con "bh_deleteElement"
+ * (ricerca lineare, oppure marcatura nell'heap pigro) e le restanti vengono estratte in ordine di scadenza.
+ */
+static double benchmarkHeap(benchmark_timeout* timeouts, bool* cancelled, bool lazy) {
+	clock_t start = clock();
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		binaryheap* h = lazy ? bh_initLazyHeap(compareTimeouts, markTimeout, isMarkedTimeout, unmarkTimeout,
+				setTimeoutPosition, getTimeoutPosition, 0) : bh_initHeap(compareTimeouts);
+		for (int i = 0; i < BENCHMARK_TIMERS; i++) {
+			bh_insertElement(h, &timeouts[i]);
+		}
+		for (int i = 0; i < BENCHMARK_TIMERS; i++) {
+			if (cancelled[i]) {
+				bh_deleteElement(h, &timeouts[i]);
+			}
+		}
+		while (bh_getHeapSize(h) > 0) {
+			expireTimeout(bh_extractRootElement(h));
+		}
+		bh_deleteHeap(h);
+	}
+	return getElapsedSeconds(start);
+}
+
+/**
+ * Percorso con il timing wheel: stesse scadenze e stesse cancellazioni, poi avanzamento fino all'ultima scadenza.
+ */
+static double benchmarkWheel(benchmark_timeout* timeouts, bool* cancelled) {
+	timerwheel_timer** timers = malloc(BENCHMARK_TIMERS * sizeof(timerwheel_timer*));
+	if (!timers) {
+		MEMORY_ERROR;
+	}
+	clock_t start = clock();
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		timerwheel* w = tw_initWheel(0);
+		for (int i = 0; i < BENCHMARK_TIMERS; i++) {
+			timers[i] = tw_scheduleElement(w, &timeouts[i], timeouts[i].expiration);
+		}
+		for (int i = 0; i < BENCHMARK_TIMERS; i++) {
+			if (cancelled[i]) {
+				tw_cancelTimer(w, timers[i]);
+			}
+		}
+		tw_advanceTicks(w, BENCHMARK_MAX_DELAY, expireTimeout);
+		tw_deleteWheel(w);
+	}
+	double elapsed = getElapsedSeconds(start);
+	free(timers);
+	return elapsed;
+}
+
+int main(void) {
+	benchmark_timeout* timeouts = malloc(BENCHMARK_TIMERS * sizeof(benchmark_timeout));
+	bool* cancelled = malloc(BENCHMARK_TIMERS * sizeof(bool));
+	if (!timeouts || !cancelled) {
+		MEMORY_ERROR;
+	}
+	srand(1);
+	for (int i = 0; i < BENCHMARK_TIMERS; i++) {
+		timeouts[i].expiration = 1 + rand() % BENCHMARK_MAX_DELAY;
+		timeouts[i].cancelled = false;
+		cancelled[i] = rand() % 100 < BENCHMARK_CANCELLED_PERCENTAGE;
+	}
+	printf("%d round da %d timer, %d%% cancellati\n", BENCHMARK_ROUNDS, BENCHMARK_TIMERS,
+			BENCHMARK_CANCELLED_PERCENTAGE);
+	long expected = -1;
+	bool consistent = true;
+	const char* names[] = {"Heap (cancellazione lineare)", "Heap pigro", "Timing wheel"};
+	for (int path = 0; path < 3; path++) {
+		benchmark_expired = 0;
+		double elapsed = path < 2 ? benchmarkHeap(timeouts, cancelled, path == 1) : benchmarkWheel(timeouts, cancelled);
+		printf("%-30s %8.3f s  (%ld scadenze)\n", names[path], elapsed, benchmark_expired);
+		consistent = consistent && (expected == -1 || expected == benchmark_expired);
+		expected = benchmark_expired;
+	}
+	free(timeouts);
+	free(cancelled);
+	if (!consistent) {
+		printf("ERRORE: numero di scadenze diverso fra i percorsi\n");
+	}
+	return !consistent;
+}
+
+#endif
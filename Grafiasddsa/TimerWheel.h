@@ -0,0 +1,44 @@
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include "BidirectionalList.h"
+
+#ifndef TIMERWHEEL_PARAMETERS
+#	define TIMERWHEEL_PARAMETERS
+#	define TIMERWHEEL_SLOT_BITS 6
+#	define TIMERWHEEL_SLOTS (1 << TIMERWHEEL_SLOT_BITS)
+#	define TIMERWHEEL_LEVELS 5
+#endif
+
+typedef struct timerwheel_timer {
+	blinked_list_node node;
+	unsigned long expiration;
+	blinked_list* slot;
+} timerwheel_timer;
+
+typedef struct timerwheel {
+	unsigned long current_tick;
+	int size;
+	int level_sizes[TIMERWHEEL_LEVELS];
+	blinked_list slots[TIMERWHEEL_LEVELS][TIMERWHEEL_SLOTS];
+	blinked_list expiring;
+} timerwheel;
+
+// Initializing Wheel
+timerwheel* tw_initWheel(unsigned long start_tick); // OK
+
+// Size
+int tw_getWheelSize(timerwheel* w); // OK
+
+// Cancelling Wheel
+void tw_deleteWheel(timerwheel* w); // OK
+void tw_purgeWheel(timerwheel* w); // OK
+
+// Scheduling Elements
+timerwheel_timer* tw_scheduleElement(timerwheel* w, void* element, unsigned long delay); // OK
+void* tw_cancelTimer(timerwheel* w, timerwheel_timer* timer); // OK
+
+// Advancing Time
+int tw_advanceTicks(timerwheel* w, unsigned long ticks, void (*expire)(void*)); // OK
+
+#endif
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "TopKCollector.h"
+
+#ifndef POSITION_OPERATIONS
+#	define POSITION_OPERATIONS
+#	define ARRAY_TO_HEAP(x) (x + 1)
+#	define HEAP_TO_ARRAY(x) (x - 1)
+#endif
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#ifndef EMPTY_SIZE
+#	define EMPTY_SIZE 0
+#endif
+
+/**
+ * Libreria che permette di mantenere i K elementi "migliori" (i.e. maggiori secondo la funzione di comparazione)
+ * di un flusso di dati di lunghezza arbitraria, utilizzando memoria O(K).
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Gli elementi trattenuti sono organizzati in un min-heap binario di capacità fissa: la radice è il peggiore
+ * degli elementi trattenuti, e costituisce la soglia che un nuovo elemento deve superare per entrare.
+ * Una volta raggiunta la capacità, ogni elemento peggiore della soglia viene scartato con un solo confronto;
+ * gli altri prendono il posto della radice con costo O(log K).
+ *
+ * <i>NOTA:</i> La funzione di comparazione ha lo stesso contratto di "bh_initHeap".
+ *
+ * <i>NOTA:</i> La numerazione degli elementi dell'heap interno inizia da 1, come per il binaryheap.
+ */
+
+/*
+typedef struct topkcollector {
+	int size;
+	int capacity;
+	void** array;
+	int (*comparefunction)(void*, void*);
+} topkcollector;
+*/
+
+// Static Utility Functions
+
+/**
+ * Fa scendere "a buco" l'elemento alla posizione data all'interno delle prime "size" posizioni del min-heap.
+ */
+static void tk_siftDown(topkcollector* c, int pos, int size) {
+	void** array = c->array;
+	void* moving = array[HEAP_TO_ARRAY(pos)];
+	int child;
+	while ((child = pos * 2) <= size) {
+		if (child < size && c->comparefunction(array[HEAP_TO_ARRAY(child + 1)], array[HEAP_TO_ARRAY(child)]) < 0) {
+			child++;	// Il secondo figlio è minore
+		}
+		if (c->comparefunction(array[HEAP_TO_ARRAY(child)], moving) >= 0) {
+			break;
+		}
+		array[HEAP_TO_ARRAY(pos)] = array[HEAP_TO_ARRAY(child)];
+		pos = child;
+	}
+	array[HEAP_TO_ARRAY(pos)] = moving;
+}
+
+// Initializing Collector
+
+/**
+ * Inizializza un collettore che tratterrà al più k elementi.
+ */
+topkcollector* tk_initCollector(int (*compare)(void*, void*), int k) {
+	topkcollector* new_collector = malloc(sizeof(topkcollector));
+	if (!new_collector) {
+		MEMORY_ERROR;
+	}
+	new_collector->size = 0;
+	new_collector->capacity = k > 0 ? k : 1;
+	new_collector->array = malloc(new_collector->capacity * sizeof(void*));
+	if (!new_collector->array) {
+		MEMORY_ERROR;
+	}
+	new_collector->comparefunction = compare;
+	return new_collector;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di elementi attualmente trattenuti (al più k).
+ */
+int tk_getCollectorSize(topkcollector* c) {
+	return c->size;
+}
+
+// Cancelling Collector
+
+/**
+ * Elimina il collettore, senza eliminare gli elementi trattenuti.
+ */
+void tk_deleteCollector(topkcollector* c) {
+	free(c->array);
+	free(c);
+}
+
+/**
+ * Elimina il collettore e gli elementi trattenuti.
+ */
+void tk_purgeCollector(topkcollector* c) {
+	for (int i = 0; i < c->size; i++) {
+		free(c->array[i]);
+	}
+	tk_deleteCollector(c);
+}
+
+// Offering Elements
+
+/**
+ * Propone un elemento al collettore.
+ * Restituisce l'elemento scartato dall'operazione: l'elemento proposto stesso, se peggiore della soglia,
+ * oppure l'elemento che è stato sostituito. Se il collettore non era ancora pieno, restituisce NULL.
+ * Questo permette al chiamante di liberare la memoria degli elementi scartati, se necessario.
+ */
+void* tk_offerElement(topkcollector* c, void* new_element) {
+	void** array = c->array;
+	if (c->size < c->capacity) {
+		// Inserimento con risalita nel min-heap
+		int pos = ++c->size;
+		while (pos > 1 && c->comparefunction(new_element, array[HEAP_TO_ARRAY(pos / 2)]) < 0) {
+			array[HEAP_TO_ARRAY(pos)] = array[HEAP_TO_ARRAY(pos / 2)];
+			pos /= 2;
+		}
+		array[HEAP_TO_ARRAY(pos)] = new_element;
+		return NULL;
+	}
+	if (c->comparefunction(new_element, array[0]) <= 0) {
+		return new_element;		// Non supera la soglia
+	}
+	void* discarded = array[0];
+	array[0] = new_element;
+	tk_siftDown(c, 1, c->size);
+	return discarded;
+}
+
+/**
+ * Propone al collettore tutti gli elementi di una lista.
+ * La lista non viene modificata, e gli elementi scartati non vengono eliminati dalla memoria.
+ */
+void tk_offerAllElements(topkcollector* c, arraylist* elements) {
+	for (int i = 0; i < elements->size; i++) {
+		tk_offerElement(c, elements->array[i]);
+	}
+}
+
+// Getting Elements
+
+/**
+ * Restituisce la soglia corrente, ossia il peggiore degli elementi trattenuti.
+ * Se il collettore non è ancora pieno ogni elemento viene accettato, e la funzione restituisce NULL.
+ */
+void* tk_getThresholdElement(topkcollector* c) {
+	if (c->size < c->capacity) {
+		return NULL;
+	}
+	return c->array[0];
+}
+
+// Extracting Elements
+
+/**
+ * Svuota il collettore, restituendo gli elementi trattenuti in una lista ordinata in modo <i>decrescente</i>
+ * (il migliore in prima posizione). L'ordinamento avviene sul posto (heapsort), in tempo O(k log k).
+ */
+arraylist* tk_drainSortedElements(topkcollector* c) {
+	int size = c->size;
+	arraylist* sorted = al_initListWithCapacity(size + 1);
+	// Porto ripetutamente il minimo in fondo: l'array risulta ordinato in modo decrescente
+	for (int last = size; last > 1; last--) {
+		void* aux = c->array[0];
+		c->array[0] = c->array[HEAP_TO_ARRAY(last)];
+		c->array[HEAP_TO_ARRAY(last)] = aux;
+		tk_siftDown(c, 1, last - 1);
+	}
+	for (int i = 0; i < size; i++) {
+		al_insertLastElement(sorted, c->array[i]);
+	}
+	c->size = 0;
+	return sorted;
+}
@@ -0,0 +1,33 @@
+#ifndef TOPKCOLLECTOR_H_
+#define TOPKCOLLECTOR_H_
+
+#include "ArrayList.h"
+
+typedef struct topkcollector {
+	int size;
+	int capacity;
+	void** array;
+	int (*comparefunction)(void*, void*);
+} topkcollector;
+
+// Initializing Collector
+topkcollector* tk_initCollector(int (*compare)(void*, void*), int k); // OK
+
+// Size
+int tk_getCollectorSize(topkcollector* c); // OK
+
+// Cancelling Collector
+void tk_deleteCollector(topkcollector* c); // OK
+void tk_purgeCollector(topkcollector* c); // OK
+
+// Offering Elements
+void* tk_offerElement(topkcollector* c, void* new_element); // OK
+void tk_offerAllElements(topkcollector* c, arraylist* elements); // OK
+
+// Getting Elements
+void* tk_getThresholdElement(topkcollector* c); // OK
+
+// Extracting Elements
+arraylist* tk_drainSortedElements(topkcollector* c); // OK
+
+#endif
@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "UnionFind.h"
+
+#ifndef MEMORY_ERROR
+#	define MEMORY_ERROR printf("Error: Cannot allocate memory.\n"); exit(1)
+#endif
+
+#define DEFAULT_ELEMENTS_CAPACITY 16
+
+/**
+ * Libreria che implementa una struttura union-find (insiemi disgiunti) sugli interi da 0 a (elements_number - 1).
+ *
+ * @author Michele Dusi <michele.dusi.it@ieee.org>
+ *
+ * Ogni insieme è un albero, rappresentato dall'array "parents" (la radice è padre di sé stessa), e il rappresentante
+ * dell'insieme è la sua radice. Le operazioni sequenziali usano l'unione per rango (la radice dell'albero più basso
+ * viene appesa a quella dell'albero più alto) e la compressione dei cammini (ogni ricerca appende direttamente alla
+ * radice i nodi attraversati), che insieme garantiscono un costo ammortizzato pressoché costante.
+ *
+ * Le operazioni concorrenti ("uf_concurrent...") possono essere invocate da più thread contemporaneamente senza lock:
+ * l'unione appende la radice di indice maggiore a quella di indice minore con un'operazione compare-and-swap (che
+ * fallisce, e viene ripetuta, se nel frattempo la radice è stata appesa da un altro thread), mentre la ricerca
+ * dimezza i cammini ("path halving") con scritture atomiche. L'ordinamento per indice sostituisce il rango, e
+ * impedisce la formazione di cicli.
+ *
+ * <i>NOTA:</i> Le operazioni sequenziali e quelle concorrenti non devono essere mescolate mentre altri thread stanno
+ * operando sulla struttura, né deve essere invocata "uf_addElement", che può riallocare gli array.
+ */
+
+/*
+typedef struct unionfind {
+	int elements_number;
+	int elements_capacity;
+	int sets_number;
+	int* parents;
+	unsigned char* ranks;
+} unionfind;
+*/
+
+// Initializing Union-Find
+
+/**
+ * Inizializza la struttura con gli elementi da 0 a (elements_number - 1), ciascuno in un insieme a sé stante.
+ */
+unionfind* uf_initUnionFind(int elements_number) {
+	unionfind* new_uf = malloc(sizeof(unionfind));
+	if (!new_uf) {
+		MEMORY_ERROR;
+	}
+	int capacity = elements_number > DEFAULT_ELEMENTS_CAPACITY ? elements_number : DEFAULT_ELEMENTS_CAPACITY;
+	new_uf->elements_number = elements_number;
+	new_uf->elements_capacity = capacity;
+	new_uf->sets_number = elements_number;
+	new_uf->parents = malloc((size_t)capacity * sizeof(int));
+	new_uf->ranks = calloc((size_t)capacity, sizeof(unsigned char));
+	if (!new_uf->parents || !new_uf->ranks) {
+		MEMORY_ERROR;
+	}
+	for (int i = 0; i < elements_number; i++) {
+		new_uf->parents[i] = i;
+	}
+	return new_uf;
+}
+
+// Size
+
+/**
+ * Restituisce il numero di elementi della struttura.
+ */
+int uf_getElementsNumber(unionfind* uf) {
+	return uf->elements_number;
+}
+
+/**
+ * Restituisce il numero di insiemi disgiunti, in tempo costante.
+ */
+int uf_getSetsNumber(unionfind* uf) {
+	return __atomic_load_n(&uf->sets_number, __ATOMIC_RELAXED);
+}
+
+// Cancelling Union-Find
+
+/**
+ * Elimina la struttura, ripulendo la memoria occupata dai suoi array.
+ */
+void uf_deleteUnionFind(unionfind* uf) {
+	free(uf->parents);
+	free(uf->ranks);
+	free(uf);
+}
+
+// Adding Elements
+
+/**
+ * Aggiunge un nuovo elemento, in un insieme a sé stante, e ne restituisce l'indice.
+ * Gli array vengono raddoppiati quando necessario, per un costo ammortizzato costante.
+ */
+int uf_addElement(unionfind* uf) {
+	if (uf->elements_number == uf->elements_capacity) {
+		uf->elements_capacity *= 2;
+		uf->parents = realloc(uf->parents, (size_t)uf->elements_capacity * sizeof(int));
+		uf->ranks = realloc(uf->ranks, (size_t)uf->elements_capacity * sizeof(unsigned char));
+		if (!uf->parents || !uf->ranks) {
+			MEMORY_ERROR;
+		}
+	}
+	int element = uf->elements_number++;
+	uf->parents[element] = element;
+	uf->ranks[element] = 0;
+	uf->sets_number++;
+	return element;
+}
+
+// Finding and Merging Sets
+
+/**
+ * Restituisce il rappresentante dell'insieme che contiene l'elemento, comprimendo il cammino percorso.
+ */
+int uf_findSet(unionfind* uf, int element) {
+	int* parents = uf->parents;
+	int root = element;
+	while (parents[root] != root) {
+		root = parents[root];
+	}
+	while (parents[element] != root) {
+		int next = parents[element];
+		parents[element] = root;
+		element = next;
+	}
+	return root;
+}
+
+/**
+ * Unisce gli insiemi che contengono i due elementi. Restituisce false se erano già lo stesso insieme.
+ */
+bool uf_unionSets(unionfind* uf, int first, int second) {
+	int first_root = uf_findSet(uf, first);
+	int second_root = uf_findSet(uf, second);
+	if (first_root == second_root) {
+		return false;
+	}
+	if (uf->ranks[first_root] < uf->ranks[second_root]) {
+		uf->parents[first_root] = second_root;
+	} else {
+		uf->parents[second_root] = first_root;
+		if (uf->ranks[first_root] == uf->ranks[second_root]) {
+			uf->ranks[first_root]++;
+		}
+	}
+	uf->sets_number--;
+	return true;
+}
+
+/**
+ * Restituisce true se i due elementi appartengono allo stesso insieme.
+ */
+bool uf_sameSet(unionfind* uf, int first, int second) {
+	return uf_findSet(uf, first) == uf_findSet(uf, second);
+}
+
+// Concurrent Operations
+
+/**
+ * Versione concorrente di "uf_findSet": ogni nodo attraversato viene appeso al proprio nonno ("path halving").
+ * Le scritture sono atomiche e idempotenti, quindi non richiedono lock: un nodo viene sempre appeso ad un suo antenato.
+ */
+int uf_concurrentFindSet(unionfind* uf, int element) {
+	int* parents = uf->parents;
+	while (true) {
+		int parent = __atomic_load_n(&parents[element], __ATOMIC_RELAXED);
+		if (parent == element) {
+			return element;
+		}
+		int grandparent = __atomic_load_n(&parents[parent], __ATOMIC_RELAXED);
+		if (grandparent != parent) {
+			__atomic_compare_exchange_n(&parents[element], &parent, grandparent,
+				false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+		}
+		element = grandparent;
+	}
+}
+
+/**
+ * Versione concorrente di "uf_unionSets": la radice di indice maggiore viene appesa a quella di indice minore con
+ * un'operazione compare-and-swap, che riesce solo se è ancora una radice; in caso contrario le radici vengono
+ * ricercate di nuovo. Restituisce false se gli elementi erano già nello stesso insieme.
+ */
+bool uf_concurrentUnionSets(unionfind* uf, int first, int second) {
+	while (true) {
+		first = uf_concurrentFindSet(uf, first);
+		second = uf_concurrentFindSet(uf, second);
+		if (first == second) {
+			return false;
+		}
+		int high = first > second ? first : second;
+		int low = first > second ? second : first;
+		int expected = high;
+		if (__atomic_compare_exchange_n(&uf->parents[high], &expected, low,
+				false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			__atomic_sub_fetch(&uf->sets_number, 1, __ATOMIC_RELAXED);
+			return true;
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#ifndef UNIONFIND_H_
+#define UNIONFIND_H_
+
+#include <stdbool.h>
+
+typedef struct unionfind {
+	int elements_number;
+	int elements_capacity;
+	int sets_number;
+	int* parents;
+	unsigned char* ranks;
+} unionfind;
+
+// Initializing Union-Find
+unionfind* uf_initUnionFind(int elements_number); // OK
+
+// Size
+int uf_getElementsNumber(unionfind* uf); // OK
+int uf_getSetsNumber(unionfind* uf); // OK
+
+// Cancelling Union-Find
+void uf_deleteUnionFind(unionfind* uf); // OK
+
+// Adding Elements
+int uf_addElement(unionfind* uf); // OK
+
+// Finding and Merging Sets
+int uf_findSet(unionfind* uf, int element); // OK
+bool uf_unionSets(unionfind* uf, int first, int second); // OK
+bool uf_sameSet(unionfind* uf, int first, int second); // OK
+
+// Concurrent Operations
+int uf_concurrentFindSet(unionfind* uf, int element); // OK
+bool uf_concurrentUnionSets(unionfind* uf, int first, int second); // OK
+
+#endif